@@ -0,0 +1,681 @@
+// Copyright 2018 Luca Di Sera
+//		Contact: disera.luca@gmail.com
+//				 https://github.com/diseraluca
+//				 https://www.linkedin.com/in/luca-di-sera-200023167
+//
+// This code is licensed under the MIT License.
+// More informations can be found in the LICENSE file in the root folder of this repository
+
+/*! \file */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace lds {
+	namespace detail {
+
+		/*!
+		 * @brief	Counts the set bits of a word
+		 */
+
+		inline std::size_t popcount(std::uint64_t word) noexcept {
+			word = word - ((word >> 1) & 0x5555555555555555ull);
+			word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+			word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+
+			return static_cast<std::size_t>((word * 0x0101010101010101ull) >> 56);
+		}
+
+		/*!
+		 * @struct	bit_chunk
+		 *
+		 * @brief	A node of a bit_immutable_list, storing bit_count elements packed in words
+		 */
+
+		struct bit_chunk {
+			static constexpr std::size_t word_bits{ 64 };
+			static constexpr std::size_t word_count{ 4 };
+			static constexpr std::size_t bit_count{ word_bits * word_count };
+
+			bit_chunk() noexcept =default;
+
+			/*!
+			 * @brief	Copies the words and the successor of other. The copy is not claimed by any list
+			 */
+
+			bit_chunk(const bit_chunk& other) noexcept : next{ other.next } {
+				for (std::size_t word{ 0 }; word < word_count; ++word) {
+					this->words[word].store(other.word(word), std::memory_order_relaxed);
+				}
+			}
+
+			bit_chunk& operator=(const bit_chunk&) =delete;
+
+			[[nodiscard]] std::uint64_t word(std::size_t index) const noexcept {
+				return this->words[index].load(std::memory_order_relaxed);
+			}
+
+			[[nodiscard]] bool test(std::size_t bit) const noexcept {
+				return (this->word(bit / word_bits) >> (bit % word_bits)) & 1u;
+			}
+
+			void set(std::size_t bit, bool value) const noexcept {
+				auto mask{ std::uint64_t{ 1 } << (bit % word_bits) };
+
+				if (value) {
+					this->words[bit / word_bits].fetch_or(mask, std::memory_order_relaxed);
+				} else {
+					this->words[bit / word_bits].fetch_and(~mask, std::memory_order_relaxed);
+				}
+			}
+
+			/*!
+			 * @brief	Writes value in the free bit just before the bit already claimed, if bit is that free bit
+			 *
+			 * Returns false when another list has already claimed bit, in which case the chunk is left untouched.
+			 */
+
+			bool claim(std::size_t bit, bool value) const noexcept {
+				auto expected{ bit + 1 };
+				if (!this->claimed.compare_exchange_strong(expected, bit)) {
+					return false;
+				}
+
+				this->set(bit, value);
+
+				return true;
+			}
+
+			// Bits are only ever written before the lowest bit claimed by a list, so that shared bits are never modified
+			mutable std::array<std::atomic<std::uint64_t>, word_count> words{};
+			mutable std::atomic<std::size_t> claimed{ 0 };
+			std::shared_ptr<const bit_chunk> next{};
+		};
+	}
+
+	class bit_immutable_list;
+
+	/*!
+	 * @class	bit_immutable_list_iterator
+	 *
+	 * @brief	An iterator over a bit-packed immutable list.
+	 *
+	 * Elements are returned by value, so that no proxy is needed.
+	 * An iterator is valid as long as a list that contains the element it points to is alive.
+	 */
+
+	class bit_immutable_list_iterator {
+		friend class bit_immutable_list;
+
+	public:
+		using value_type = bool;
+		using reference = value_type;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+	public:
+		bit_immutable_list_iterator() =default;
+
+	public:
+		friend bool operator==(const bit_immutable_list_iterator& left, const bit_immutable_list_iterator& right) noexcept {
+			return left.chunk == right.chunk && left.bit == right.bit;
+		}
+
+		friend bool operator!=(const bit_immutable_list_iterator& left, const bit_immutable_list_iterator& right) noexcept {
+			return !(left == right);
+		}
+
+		bit_immutable_list_iterator& operator++() noexcept;
+		bit_immutable_list_iterator operator++(int) noexcept;
+
+		[[nodiscard]] reference operator*() const noexcept;
+
+	private:
+		bit_immutable_list_iterator(const detail::bit_chunk* chunk, std::size_t bit) noexcept : chunk{ chunk }, bit{ bit } {}
+
+	private:
+		const detail::bit_chunk* chunk{ nullptr };
+		std::size_t bit{ 0 };
+	};
+
+	/*!
+	 * @class	bit_immutable_list
+	 *
+	 * @brief	A bit-packed immutable list of bool, for when the footprint of immutable_list<bool> is too high
+	 *
+	 * Elements are packed 64 to a word, in chunks of detail::bit_chunk::bit_count elements.
+	 * The first chunk of a list may be partially used, while all the chunks that follow it are full, so that the layout of a chunk
+	 * never depends on the elements that precede it and chunks can be shared between lists.
+	 * 
+	 * push_front writes in the free bit before the first element of the first chunk, which it shares with this list,
+	 * so that a chain of push_front calls allocates a new chunk only once every bit_count elements.
+	 * Only the first list to push in front of a given list can take the free bit: the others work on a copy of the first chunk.
+	 * pop_front never allocates.
+	 * Modifiers that edit the list after its first element copy the chunks up to the edited position and share all the following ones.
+	 * 
+	 * count and any work on whole words.
+	 */
+
+	class bit_immutable_list {
+		friend class bit_immutable_list_iterator;
+
+	public:
+		using value_type = bool;
+		using reference = value_type;
+		using const_reference = value_type;
+		using const_iterator = bit_immutable_list_iterator;
+		using size_type = std::size_t;
+
+	public:
+
+		/*! @name Constructors
+	     */
+	     ///@{
+
+		bit_immutable_list() noexcept : head{}, offset{ 0 }, m_size{ 0 } {}
+
+		explicit bit_immutable_list(value_type data);
+
+		template <typename InputIterator,
+			      typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+		bit_immutable_list(InputIterator first, InputIterator last);
+
+		explicit bit_immutable_list(std::initializer_list<bool> list) : bit_immutable_list(list.begin(), list.end()) {}
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Element Access
+		 */
+		///@{
+
+		[[nodiscard]] const_reference front() const;
+
+		const_reference at(size_type index) const;
+		const_reference operator[](size_type index) const;
+
+		///@}
+
+	public:
+
+		/*! @name Iterators
+		 */
+		 ///@{
+
+		[[nodiscard]] const_iterator cbegin() const noexcept {
+			return const_iterator{ this->head.get(), this->offset };
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept {
+			return const_iterator{};
+		}
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Modifiers
+		 *
+		 * Each modifier return a new list that models the result of a modification.
+		 * The original list isn't modified in any way.
+		 *
+		 * Modifiers ensures a Strong Exception Garuantee
+		 */
+		///@{
+
+		[[nodiscard]] bit_immutable_list clear() const noexcept;
+
+		[[nodiscard]] bit_immutable_list push_front(value_type data) const;
+
+		template <typename ...Args>
+		[[nodiscard]] bit_immutable_list emplace_front(Args&&... args) const;
+
+		[[nodiscard]] bit_immutable_list pop_front() const noexcept;
+
+		[[nodiscard]] bit_immutable_list insert_after(const_iterator pos, value_type value) const;
+		[[nodiscard]] bit_immutable_list insert_after(const_iterator pos, size_type count, value_type value) const;
+
+		[[nodiscard]] bit_immutable_list erase_after(const_iterator pos) const;
+		[[nodiscard]] bit_immutable_list erase_after(const_iterator first, const_iterator last) const;
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Capacity
+		 */
+		 ///@{
+
+		[[nodiscard]] bool empty() const noexcept;
+
+		[[nodiscard]] size_type size() const noexcept;
+
+		[[nodiscard]] constexpr size_type max_size() const noexcept;
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Bit operations
+		 */
+		 ///@{
+
+		[[nodiscard]] size_type count() const noexcept;
+
+		[[nodiscard]] bool any() const noexcept;
+
+		///@}
+
+	public: // OPERATORS
+		friend bool operator==(const bit_immutable_list& left, const bit_immutable_list& right) {
+			return left.m_size == right.m_size && std::equal(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+		}
+
+		friend bool operator!=(const bit_immutable_list& left, const bit_immutable_list& right) {
+			return !(left == right);
+		}
+
+	private:
+		using Chunk = detail::bit_chunk;
+
+		bit_immutable_list(std::shared_ptr<const Chunk> head, size_type offset, size_type size) noexcept : head{ std::move(head) }, offset{ offset }, m_size{ size } {}
+
+		template <typename ForwardIterator>
+		[[nodiscard]] static bit_immutable_list prepend_chunks(ForwardIterator first, size_type count, std::shared_ptr<const Chunk> suffix, size_type suffixSize);
+
+		[[nodiscard]] bit_immutable_list splice(std::vector<bool>&& prefix, const_iterator suffixStart, size_type suffixSize) const;
+
+		[[nodiscard]] std::vector<bool> copy_prefix(const_iterator pos) const;
+
+		template <typename WordVisitor>
+		void visit_words(WordVisitor visitor) const;
+
+	private:
+		std::shared_ptr<const Chunk> head;
+
+		// The position, in the first chunk, of the first element of the list
+		size_type offset;
+		size_type m_size;
+	};
+
+	/*!
+	 * @brief	Constructs a single-element list with containing the passed in data
+	 */
+
+	inline bit_immutable_list::bit_immutable_list(value_type data) : bit_immutable_list()
+	{
+		*this = this->push_front(data);
+	}
+
+	/*!
+	 * @brief	Constructs a new list from the content of the range [first, last)
+	 *
+	 * The range must be valid and last must be reachable from first.
+	 * An empty range (first == last) creates an empty list.
+	 */
+
+	template <typename InputIterator, typename>
+	inline bit_immutable_list::bit_immutable_list(InputIterator first, InputIterator last) : bit_immutable_list()
+	{
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>) {
+			*this = prepend_chunks(first, static_cast<size_type>(std::distance(first, last)), nullptr, 0);
+		} else {
+			std::vector<bool> elements(first, last);
+			*this = prepend_chunks(elements.cbegin(), elements.size(), nullptr, 0);
+		}
+	}
+
+	/*!
+	 * @brief	Gets the first element of the container
+	 *
+	 * Calling front on an empty list is considered undefined behaviour.
+	 */
+
+	inline bit_immutable_list::const_reference bit_immutable_list::front() const
+	{
+		return this->head->test(this->offset);
+	}
+
+	/*!
+	 * @brief	Gets the ith element of the list. at is range checked.
+	 *
+	 * @exception	std::out_of_range	Thrown when index >= size().
+	 */
+
+	inline bit_immutable_list::const_reference bit_immutable_list::at(size_type index) const
+	{
+		if (index >= this->m_size) {
+			throw std::out_of_range((std::stringstream() << "The list does not contain index " << index).str());
+		}
+
+		return (*this)[index];
+	}
+
+	/*!
+	 * @brief	Gets the ith element of the list.
+	 *
+	 * Whole chunks are skipped, so that the cost is proportional to index / bit_count.
+	 */
+
+	inline bit_immutable_list::const_reference bit_immutable_list::operator[](size_type index) const
+	{
+		index += this->offset;
+
+		const Chunk* chunk{ this->head.get() };
+		for (; index >= Chunk::bit_count; index -= Chunk::bit_count) {
+			chunk = chunk->next.get();
+		}
+
+		return chunk->test(index);
+	}
+
+	inline bit_immutable_list bit_immutable_list::clear() const noexcept
+	{
+		return bit_immutable_list();
+	}
+
+	/*!
+	 * @brief	Generates a new list with an element prepended to it
+	 *
+	 * When this list is the first to push in front of its first element, the element takes the free bit before it and the new list
+	 * shares the first chunk of this list, without allocating.
+	 * Otherwise the first chunk is copied, or, when it is full, a new chunk is allocated.
+	 */
+
+	inline bit_immutable_list bit_immutable_list::push_front(value_type data) const
+	{
+		if (this->head && this->offset > 0) {
+			if (this->head->claim(this->offset - 1, data)) {
+				return bit_immutable_list(this->head, this->offset - 1, this->m_size + 1);
+			}
+
+			auto chunk{ std::make_shared<Chunk>(*this->head) };
+			chunk->set(this->offset - 1, data);
+			chunk->claimed.store(this->offset - 1, std::memory_order_relaxed);
+
+			return bit_immutable_list(std::move(chunk), this->offset - 1, this->m_size + 1);
+		}
+
+		auto chunk{ std::make_shared<Chunk>() };
+		chunk->set(Chunk::bit_count - 1, data);
+		chunk->claimed.store(Chunk::bit_count - 1, std::memory_order_relaxed);
+		chunk->next = this->head;
+
+		return bit_immutable_list(std::move(chunk), Chunk::bit_count - 1, this->m_size + 1);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template <typename ...Args>
+	inline bit_immutable_list bit_immutable_list::emplace_front(Args&&... args) const
+	{
+		return this->push_front(value_type(std::forward<Args>(args)...));
+	}
+
+	/*!
+	 * @brief	Generates a new list with an the front element removed
+	 *
+	 * Never allocates, as the new list shares all the chunks of this list.
+	 */
+
+	inline bit_immutable_list bit_immutable_list::pop_front() const noexcept
+	{
+		if (this->offset + 1 == Chunk::bit_count) {
+			return bit_immutable_list(this->head->next, 0, this->m_size - 1);
+		}
+
+		return bit_immutable_list(this->head, this->offset + 1, this->m_size - 1);
+	}
+
+	/*!
+	 * @brief	Generates a new list with one or more elements inserted after the given position
+	 *
+	 * The chunks that contain the range [begin, pos] are copied, while all the following ones are shared.
+	 */
+
+	inline bit_immutable_list bit_immutable_list::insert_after(const_iterator pos, value_type value) const
+	{
+		return this->insert_after(pos, 1, value);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	inline bit_immutable_list bit_immutable_list::insert_after(const_iterator pos, size_type count, value_type value) const
+	{
+		auto prefix{ this->copy_prefix(pos) };
+		auto prefixSize{ prefix.size() };
+		prefix.insert(prefix.end(), count, value);
+
+		return this->splice(std::move(prefix), ++pos, this->m_size - prefixSize);
+	}
+
+	/*!
+	 * @brief	Generates a new list with one or more elements removed after the given position
+	 *
+	 * The chunks that contain the range [begin, pos] are copied, while all the chunks after the removed elements are shared.
+	 */
+
+	inline bit_immutable_list bit_immutable_list::erase_after(const_iterator pos) const
+	{
+		auto prefix{ this->copy_prefix(pos) };
+		auto prefixSize{ prefix.size() };
+
+		return this->splice(std::move(prefix), std::next(pos, 2), this->m_size - prefixSize - 1);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	inline bit_immutable_list bit_immutable_list::erase_after(const_iterator first, const_iterator last) const
+	{
+		if (first == last) {
+			return *this;
+		}
+
+		auto prefix{ this->copy_prefix(first) };
+		auto erasedCount{ static_cast<size_type>(std::distance(first, last)) - 1 };
+		auto prefixSize{ prefix.size() };
+
+		return this->splice(std::move(prefix), last, this->m_size - prefixSize - erasedCount);
+	}
+
+	inline bool bit_immutable_list::empty() const noexcept
+	{
+		return !this->m_size;
+	}
+
+	inline bit_immutable_list::size_type bit_immutable_list::size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	inline constexpr bit_immutable_list::size_type bit_immutable_list::max_size() const noexcept
+	{
+		return std::numeric_limits<size_type>::max();
+	}
+
+	/*!
+	 * @brief	Counts the elements that are true
+	 *
+	 * Works on whole words.
+	 */
+
+	inline bit_immutable_list::size_type bit_immutable_list::count() const noexcept
+	{
+		size_type setBits{ 0 };
+		this->visit_words([&setBits](std::uint64_t word) { setBits += detail::popcount(word); return true; });
+
+		return setBits;
+	}
+
+	/*!
+	 * @brief	Checks if at least one element is true
+	 *
+	 * Works on whole words and stops at the first word with a bit set.
+	 */
+
+	inline bool bit_immutable_list::any() const noexcept
+	{
+		bool found{ false };
+		this->visit_words([&found](std::uint64_t word) { found = word != 0; return !found; });
+
+		return found;
+	}
+
+	/*!
+	 * @brief	Calls visitor on each word of the list, with the bits that precede the first element cleared, until visitor returns false
+	 */
+
+	template <typename WordVisitor>
+	inline void bit_immutable_list::visit_words(WordVisitor visitor) const
+	{
+		if (this->empty()) {
+			return;
+		}
+
+		auto firstWord{ this->offset / Chunk::word_bits };
+		auto firstWordMask{ ~std::uint64_t{ 0 } << (this->offset % Chunk::word_bits) };
+
+		if (!visitor(this->head->word(firstWord) & firstWordMask)) {
+			return;
+		}
+
+		for (auto word{ firstWord + 1 }; word < Chunk::word_count; ++word) {
+			if (!visitor(this->head->word(word))) {
+				return;
+			}
+		}
+
+		for (const Chunk* chunk{ this->head->next.get() }; chunk; chunk = chunk->next.get()) {
+			for (const auto& word : chunk->words) {
+				if (!visitor(word.load(std::memory_order_relaxed))) {
+					return;
+				}
+			}
+		}
+	}
+
+	/*!
+	 * @brief	Builds the chunks for the count elements starting at first, in front of suffix
+	 *
+	 * suffix must be either empty or a full chunk, so that the new elements fill the new chunks from the back.
+	 */
+
+	template <typename ForwardIterator>
+	inline bit_immutable_list bit_immutable_list::prepend_chunks(ForwardIterator first, size_type count, std::shared_ptr<const Chunk> suffix, size_type suffixSize)
+	{
+		if (count == 0) {
+			return bit_immutable_list(std::move(suffix), 0, suffixSize);
+		}
+
+		auto chunkCount{ (count + Chunk::bit_count - 1) / Chunk::bit_count };
+		auto headOffset{ chunkCount * Chunk::bit_count - count };
+
+		std::shared_ptr<Chunk> newHead{ std::make_shared<Chunk>() };
+		Chunk* current{ newHead.get() };
+		for (auto bit{ headOffset }; count > 0; --count, ++first, ++bit) {
+			if (bit == Chunk::bit_count) {
+				auto nextChunk{ std::make_shared<Chunk>() };
+				current->next = nextChunk;
+				current = nextChunk.get();
+				bit = 0;
+			}
+
+			current->set(bit, *first);
+		}
+		current->next = std::move(suffix);
+		newHead->claimed.store(headOffset, std::memory_order_relaxed);
+
+		return bit_immutable_list(std::move(newHead), headOffset, chunkCount * Chunk::bit_count - headOffset + suffixSize);
+	}
+
+	/*!
+	 * @brief	Generates a list made of prefix followed by the elements of this list in the range [suffixStart, end)
+	 *
+	 * When suffixStart is not at the start of a chunk, the rest of its chunk is copied too, so that all the shared chunks are full.
+	 */
+
+	inline bit_immutable_list bit_immutable_list::splice(std::vector<bool>&& prefix, const_iterator suffixStart, size_type suffixSize) const
+	{
+		// Finds the owning pointer to the chunk of suffixStart
+		const std::shared_ptr<const Chunk>* owner{ &this->head };
+		while (*owner && owner->get() != suffixStart.chunk) {
+			owner = &(*owner)->next;
+		}
+		auto suffix{ *owner };
+
+		if (suffix && suffixStart.bit > 0) {
+			for (auto bit{ suffixStart.bit }; bit < Chunk::bit_count; ++bit) {
+				prefix.push_back(suffix->test(bit));
+			}
+
+			suffixSize -= Chunk::bit_count - suffixStart.bit;
+			suffix = suffix->next;
+		}
+
+		return prepend_chunks(prefix.cbegin(), prefix.size(), std::move(suffix), suffixSize);
+	}
+
+	/*!
+	 * @brief	Copies the elements in the range [begin, pos]
+	 */
+
+	inline std::vector<bool> bit_immutable_list::copy_prefix(const_iterator pos) const
+	{
+		std::vector<bool> prefix{};
+		for (auto element{ this->cbegin() }; element != pos; ++element) {
+			prefix.push_back(*element);
+		}
+		prefix.push_back(*pos);
+
+		return prefix;
+	}
+
+	// BIT_IMMUTABLE_LIST_ITERATOR IMPLEMENTATION //
+
+	inline bit_immutable_list_iterator& bit_immutable_list_iterator::operator++() noexcept
+	{
+		if (++this->bit == detail::bit_chunk::bit_count) {
+			this->chunk = this->chunk->next.get();
+			this->bit = 0;
+		}
+
+		return *this;
+	}
+
+	inline bit_immutable_list_iterator bit_immutable_list_iterator::operator++(int) noexcept
+	{
+		bit_immutable_list_iterator previous{ *this };
+		++(*this);
+
+		return previous;
+	}
+
+	inline bit_immutable_list_iterator::reference bit_immutable_list_iterator::operator*() const noexcept
+	{
+		return this->chunk->test(this->bit);
+	}
+}
@@ -0,0 +1,540 @@
+// Copyright 2018 Luca Di Sera
+//		Contact: disera.luca@gmail.com
+//				 https://github.com/diseraluca
+//				 https://www.linkedin.com/in/luca-di-sera-200023167
+//
+// This code is licensed under the MIT License.
+// More informations can be found in the LICENSE file in the root folder of this repository
+
+/*! \file */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+
+namespace lds {
+	template <typename Integral, std::size_t BlockBytes>
+	class compressed_immutable_list;
+
+	namespace detail {
+
+		/*!
+		 * @brief	Maps signed differences to unsigned values so that differences of small magnitude, of both signs, have few significant bits
+		 */
+
+		template <typename Unsigned>
+		constexpr Unsigned zigzag_encode(Unsigned difference) noexcept {
+			constexpr auto signBit{ sizeof(Unsigned) * CHAR_BIT - 1 };
+
+			return static_cast<Unsigned>(difference << 1) ^ static_cast<Unsigned>(Unsigned{ 0 } - (difference >> signBit));
+		}
+
+		template <typename Unsigned>
+		constexpr Unsigned zigzag_decode(Unsigned encoded) noexcept {
+			return static_cast<Unsigned>(encoded >> 1) ^ static_cast<Unsigned>(Unsigned{ 0 } - (encoded & 1));
+		}
+
+		template <typename Unsigned>
+		constexpr std::size_t varint_size(Unsigned value) noexcept {
+			std::size_t size{ 1 };
+			for (; value >= 0x80; value >>= 7) {
+				++size;
+			}
+
+			return size;
+		}
+
+		template <typename Unsigned>
+		inline unsigned char* varint_write(Unsigned value, unsigned char* output) noexcept {
+			for (; value >= 0x80; value >>= 7) {
+				*output++ = static_cast<unsigned char>(value | 0x80);
+			}
+			*output++ = static_cast<unsigned char>(value);
+
+			return output;
+		}
+
+		template <typename Unsigned>
+		inline const unsigned char* varint_read(const unsigned char* input, Unsigned& value) noexcept {
+			value = 0;
+			for (unsigned shift{ 0 }; ; shift += 7) {
+				unsigned char byte{ *input++ };
+				value |= static_cast<Unsigned>(static_cast<Unsigned>(byte & 0x7F) << shift);
+
+				if (!(byte & 0x80)) {
+					return input;
+				}
+			}
+		}
+	}
+
+	/*!
+	 * @class	compressed_immutable_list_iterator
+	 *
+	 * @brief	A compressed immutable list iterator.
+	 *
+	 * Elements are decoded while the iterator advances and are returned by value.
+	 * An iterator is valid as long as a list that contains the element it points to is alive.
+	 *
+	 * @tparam	Integral	Integral type parameter.
+	 * @tparam	BlockBytes	The number of bytes available for the differences in each block.
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	class compressed_immutable_list_iterator {
+		friend class compressed_immutable_list<Integral, BlockBytes>;
+
+	public:
+		using value_type = Integral;
+		using reference = value_type;
+		using pointer = const value_type*;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+	public:
+		compressed_immutable_list_iterator() =default;
+
+	public:
+		friend bool operator==(const compressed_immutable_list_iterator& left, const compressed_immutable_list_iterator& right) noexcept {
+			return left.block == right.block && left.position == right.position;
+		}
+
+		friend bool operator!=(const compressed_immutable_list_iterator& left, const compressed_immutable_list_iterator& right) noexcept {
+			return !(left == right);
+		}
+
+		compressed_immutable_list_iterator& operator++();
+		compressed_immutable_list_iterator operator++(int);
+
+		[[nodiscard]] reference operator*() const noexcept { return this->value; }
+		[[nodiscard]] pointer operator->() const noexcept { return &this->value; }
+
+	private:
+		using Block = typename compressed_immutable_list<Integral, BlockBytes>::Block;
+		using Slice = typename compressed_immutable_list<Integral, BlockBytes>::Slice;
+
+		explicit compressed_immutable_list_iterator(const Slice& slice) noexcept
+			: block{ slice.block.get() }, position{ slice.block ? slice.block->deltas.data() + slice.offset : nullptr }, value{ slice.first } {}
+
+	private:
+		const Block* block{ nullptr };
+
+		// The position, in the differences of the block, of the next element's difference, or the end of the block after its last element
+		const unsigned char* position{ nullptr };
+		value_type value{};
+	};
+
+	/*!
+	 * @class	compressed_immutable_list
+	 *
+	 * @brief	An immutable singly-linked list of integral values that stores its elements in compressed blocks
+	 *
+	 * Each block stores its first element as is and every following element as the zigzag, varint encoded difference from the element before it.
+	 * Sequences of close values, such as monotone timestamps or identifiers, need one or two bytes per element.
+	 *
+	 * Blocks are shared between lists. The differences are written from the end of a block towards its beginning, so that the first list
+	 * to push in front of the first element of a block writes the new difference in place and shares the block, without allocating.
+	 * Other lists copy the used part of the first block, whose size is bounded by BlockBytes, and share all the following ones.
+	 * Removing the first element never allocates.
+	 *
+	 * Elements are decoded while iterating, so that element access is by value.
+	 *
+	 * @tparam	Integral	Integral type parameter.
+	 * @tparam	BlockBytes	The number of bytes available for the differences in each block.
+	 */
+
+	template <typename Integral, std::size_t BlockBytes = 256>
+	class compressed_immutable_list {
+		static_assert(std::is_integral_v<Integral> && !std::is_same_v<Integral, bool>, "compressed_immutable_list requires a non-bool integral type");
+		static_assert(BlockBytes >= 2 * sizeof(Integral), "BlockBytes must be big enough to store the largest encoded difference");
+
+		friend class compressed_immutable_list_iterator<Integral, BlockBytes>;
+
+	public:
+		using value_type = Integral;
+		using reference = value_type;
+		using const_reference = value_type;
+		using const_iterator = compressed_immutable_list_iterator<Integral, BlockBytes>;
+		using size_type = std::size_t;
+
+	public:
+
+		/*! @name Constructors
+	     */
+	     ///@{
+
+		compressed_immutable_list() noexcept : head{}, m_size{ 0 } {}
+
+		explicit compressed_immutable_list(value_type data);
+
+		template <typename InputIterator,
+			      typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+		compressed_immutable_list(InputIterator first, InputIterator last);
+
+		explicit compressed_immutable_list(std::initializer_list<value_type> list) : compressed_immutable_list(list.begin(), list.end()) {}
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Element Access
+		 */
+		///@{
+
+		[[nodiscard]] const_reference front() const;
+
+		const_reference at(size_type index) const;
+		const_reference operator[](size_type index) const;
+
+		///@}
+
+	public:
+
+		/*! @name Iterators
+		 */
+		 ///@{
+
+		[[nodiscard]] const_iterator cbegin() const noexcept {
+			return const_iterator{ this->head };
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept {
+			return const_iterator{};
+		}
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Modifiers
+		 *
+		 * Each modifier return a new list that models the result of a modification.
+		 * The original list isn't modified in any way.
+		 *
+		 * Modifiers ensures a Strong Exception Garuantee
+		 */
+		///@{
+
+		[[nodiscard]] compressed_immutable_list clear() const noexcept;
+
+		[[nodiscard]] compressed_immutable_list push_front(value_type data) const;
+
+		[[nodiscard]] compressed_immutable_list pop_front() const;
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Capacity
+		 */
+		 ///@{
+
+		[[nodiscard]] bool empty() const noexcept;
+
+		[[nodiscard]] size_type size() const noexcept;
+
+		[[nodiscard]] constexpr size_type max_size() const noexcept;
+
+		///@}
+
+	public: // OPERATORS
+		friend bool operator==(const compressed_immutable_list& left, const compressed_immutable_list& right) {
+			return left.m_size == right.m_size && std::equal(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+		}
+
+		friend bool operator!=(const compressed_immutable_list& left, const compressed_immutable_list& right) {
+			return !(left == right);
+		}
+
+	private:
+		using unsigned_type = std::make_unsigned_t<value_type>;
+
+		struct Block;
+
+		// The elements of a block that a list holds: first, stored as is, and count - 1 differences from offset to the end of the block
+		struct Slice {
+			std::shared_ptr<const Block> block;
+			value_type first;
+			size_type offset;
+			size_type count;
+		};
+
+		struct Block {
+
+			/*!
+			 * @brief	Claims the size bytes just before offset, the lowest offset already claimed, for the list that pushes in front of the slice starting at offset
+			 *
+			 * Returns false when another list has already claimed the bytes before offset.
+			 */
+
+			bool claim(size_type offset, size_type size) const noexcept {
+				return this->claimed.compare_exchange_strong(offset, offset - size);
+			}
+
+			// Differences are only ever written before the lowest offset claimed by a list, so that the differences held by a list are never modified
+			mutable std::array<unsigned char, BlockBytes> deltas;
+			mutable std::atomic<size_type> claimed{ BlockBytes };
+			Slice next{};
+		};
+
+		[[nodiscard]] static unsigned_type encoded_difference(value_type from, value_type to) noexcept {
+			return detail::zigzag_encode(static_cast<unsigned_type>(static_cast<unsigned_type>(to) - static_cast<unsigned_type>(from)));
+		}
+
+		compressed_immutable_list(Slice head, size_type size) noexcept : head{ std::move(head) }, m_size{ size } {}
+
+		Slice head;
+		size_type m_size;
+	};
+
+	/*!
+	 * @brief	Constructs a single-element list with containing the passed in data
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	inline compressed_immutable_list<Integral, BlockBytes>::compressed_immutable_list(value_type data) : head{ std::make_shared<Block>(), data, BlockBytes, 1 }, m_size{ 1 } {}
+
+	/*!
+	 * @brief	Constructs a new list from the content of the range [first, last)
+	 *
+	 * The range must be valid and last must be reachable from first.
+	 * Each block is filled before starting a new one. The differences are written from the beginning of the block and moved to its end once it is full.
+	 *
+	 * @param	first	The first element of the range
+	 * @param	last 	The last element of the range
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	template <typename InputIterator, typename>
+	inline compressed_immutable_list<Integral, BlockBytes>::compressed_immutable_list(InputIterator first, InputIterator last) : head{}, m_size{ 0 }
+	{
+		Slice* slice{ &this->head };
+		std::shared_ptr<Block> current{};
+		size_type used{ 0 };
+		value_type previous{};
+
+		auto close{ [&]() {
+			std::copy_backward(current->deltas.data(), current->deltas.data() + used, current->deltas.data() + BlockBytes);
+			slice->offset = BlockBytes - used;
+			current->claimed.store(slice->offset, std::memory_order_relaxed);
+		} };
+
+		for (; first != last; ++first, ++this->m_size) {
+			value_type data{ *first };
+			unsigned_type difference{ encoded_difference(previous, data) };
+			previous = data;
+
+			if (current && used + detail::varint_size(difference) <= BlockBytes) {
+				used = static_cast<size_type>(detail::varint_write(difference, current->deltas.data() + used) - current->deltas.data());
+				++slice->count;
+
+				continue;
+			}
+
+			auto block{ std::make_shared<Block>() };
+			if (current) {
+				close();
+				slice = &current->next;
+			}
+
+			*slice = Slice{ block, data, 0, 1 };
+			current = std::move(block);
+			used = 0;
+		}
+
+		if (current) {
+			close();
+		}
+	}
+
+	/*!
+	 * @brief	Gets the first element of the container
+	 *
+	 * Calling front on an empty list is considered undefined behaviour.
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	typename inline compressed_immutable_list<Integral, BlockBytes>::const_reference compressed_immutable_list<Integral, BlockBytes>::front() const
+	{
+		return this->head.first;
+	}
+
+	/*!
+	 * @brief	Gets the ith element of the list. at is range checked.
+	 *
+	 * @exception	std::out_of_range	Thrown when index >= size().
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	typename inline compressed_immutable_list<Integral, BlockBytes>::const_reference compressed_immutable_list<Integral, BlockBytes>::at(size_type index) const
+	{
+		if (index >= this->m_size) {
+			throw std::out_of_range((std::stringstream() << "The list does not contain index " << index).str());
+		}
+
+		return (*this)[index];
+	}
+
+	/*!
+	 * @brief	Gets the ith element of the list.
+	 *
+	 * Whole blocks are skipped without being decoded.
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	typename inline compressed_immutable_list<Integral, BlockBytes>::const_reference compressed_immutable_list<Integral, BlockBytes>::operator[](size_type index) const
+	{
+		const Slice* slice{ &this->head };
+		for (; index >= slice->count; slice = &slice->block->next) {
+			index -= slice->count;
+		}
+
+		return *std::next(const_iterator{ *slice }, index);
+	}
+
+	/*!
+	 * @brief	Creates a new list with no elements from this list.
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	inline compressed_immutable_list<Integral, BlockBytes> compressed_immutable_list<Integral, BlockBytes>::clear() const noexcept
+	{
+		return compressed_immutable_list<Integral, BlockBytes>();
+	}
+
+	/*!
+	 * @brief	Generates a new list with an element prepended to it
+	 *
+	 * When this list is the first to push in front of its first element, the difference from it takes the free bytes before it
+	 * and the new list shares the first block of this list, without allocating.
+	 * Otherwise the used part of the first block is copied, or, when the difference does not fit, a new block is allocated.
+	 * All the other blocks are shared.
+	 *
+	 * @param	data	The data to prepend.
+	 *
+	 * @returns	A new list with an element prepended.
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	inline compressed_immutable_list<Integral, BlockBytes> compressed_immutable_list<Integral, BlockBytes>::push_front(value_type data) const
+	{
+		if (this->head.block) {
+			unsigned_type difference{ encoded_difference(data, this->head.first) };
+			auto differenceSize{ detail::varint_size(difference) };
+
+			if (differenceSize <= this->head.offset) {
+				auto offset{ this->head.offset - differenceSize };
+
+				if (this->head.block->claim(this->head.offset, differenceSize)) {
+					detail::varint_write(difference, this->head.block->deltas.data() + offset);
+
+					return compressed_immutable_list<Integral, BlockBytes>(Slice{ this->head.block, data, offset, this->head.count + 1 }, this->m_size + 1);
+				}
+
+				auto block{ std::make_shared<Block>() };
+				std::copy(this->head.block->deltas.data() + this->head.offset, this->head.block->deltas.data() + BlockBytes, block->deltas.data() + this->head.offset);
+				detail::varint_write(difference, block->deltas.data() + offset);
+				block->claimed.store(offset, std::memory_order_relaxed);
+				block->next = this->head.block->next;
+
+				return compressed_immutable_list<Integral, BlockBytes>(Slice{ std::move(block), data, offset, this->head.count + 1 }, this->m_size + 1);
+			}
+		}
+
+		auto block{ std::make_shared<Block>() };
+		block->next = this->head;
+
+		return compressed_immutable_list<Integral, BlockBytes>(Slice{ std::move(block), data, BlockBytes, 1 }, this->m_size + 1);
+	}
+
+	/*!
+	 * @brief	Generates a new list with an the front element removed
+	 *
+	 * The new list shares the first block of this list, starting after the difference of the removed element.
+	 * Calling pop_front on an empty list is considered undefined behaviour.
+	 *
+	 * @returns	A new list with the front element removed
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	inline compressed_immutable_list<Integral, BlockBytes> compressed_immutable_list<Integral, BlockBytes>::pop_front() const
+	{
+		if (this->head.count == 1) {
+			return compressed_immutable_list<Integral, BlockBytes>(this->head.block->next, this->m_size - 1);
+		}
+
+		unsigned_type difference{};
+		auto rest{ detail::varint_read(this->head.block->deltas.data() + this->head.offset, difference) };
+		auto first{ static_cast<value_type>(static_cast<unsigned_type>(this->head.first) + detail::zigzag_decode(difference)) };
+
+		return compressed_immutable_list<Integral, BlockBytes>(Slice{ this->head.block, first, static_cast<size_type>(rest - this->head.block->deltas.data()), this->head.count - 1 }, this->m_size - 1);
+	}
+
+	/*!
+	 * @brief	Checks if the list is empty
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	inline bool compressed_immutable_list<Integral, BlockBytes>::empty() const noexcept
+	{
+		return !this->m_size;
+	}
+
+	/*!
+	 * @brief	Gets the current number of elements in the list
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	typename inline compressed_immutable_list<Integral, BlockBytes>::size_type compressed_immutable_list<Integral, BlockBytes>::size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	/*!
+	 * @brief	Gets the theorethical maximum size of a list
+	 */
+
+	template <typename Integral, std::size_t BlockBytes>
+	typename inline constexpr compressed_immutable_list<Integral, BlockBytes>::size_type compressed_immutable_list<Integral, BlockBytes>::max_size() const noexcept
+	{
+		return std::numeric_limits<size_type>::max();
+	}
+
+	// COMPRESSED_IMMUTABLE_LIST_ITERATOR IMPLEMENTATION //
+
+	template <typename Integral, std::size_t BlockBytes>
+	inline compressed_immutable_list_iterator<Integral, BlockBytes>& compressed_immutable_list_iterator<Integral, BlockBytes>::operator++()
+	{
+		if (this->position != this->block->deltas.data() + BlockBytes) {
+			typename compressed_immutable_list<Integral, BlockBytes>::unsigned_type difference{};
+			this->position = detail::varint_read(this->position, difference);
+			this->value = static_cast<value_type>(static_cast<decltype(difference)>(this->value) + detail::zigzag_decode(difference));
+
+			return *this;
+		}
+
+		*this = compressed_immutable_list_iterator<Integral, BlockBytes>{ this->block->next };
+
+		return *this;
+	}
+
+	template <typename Integral, std::size_t BlockBytes>
+	inline compressed_immutable_list_iterator<Integral, BlockBytes> compressed_immutable_list_iterator<Integral, BlockBytes>::operator++(int)
+	{
+		compressed_immutable_list_iterator<Integral, BlockBytes> previous{ *this };
+		++(*this);
+
+		return previous;
+	}
+}
@@ -13,13 +13,508 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace lds {
 	template <typename T>
 	class immutable_list;
 
+	template <typename T>
+	class frozen_list;
+
+	/*!
+	 * @struct	boxed_payload
+	 *
+	 * @brief	Customization point that makes immutable_list store elements of type T behind a shared, immutable box
+	 *
+	 * By default the nodes of an immutable_list store their element by value, so that the modifiers that copy a prefix of the list
+	 * copy-construct each element of the prefix.
+	 * Specializing boxed_payload<T> to derive from std::true_type makes each node reference its element through a std::shared_ptr<const T>,
+	 * so that copying a node only copies a pointer. This costs one more allocation and indirection per element and is meant for large or expensive to copy types.
+	 *
+	 * @tparam	T	The element type.
+	 */
+
+	template <typename T>
+	struct boxed_payload : std::false_type {};
+
+	template <typename T>
+	inline constexpr bool boxed_payload_v = boxed_payload<T>::value;
+
+	/*!
+	 * @brief	The execution policies accepted by the sorting functions
+	 *
+	 * They mirror the ones of the standard library, which can not be used without linking a parallel backend on some implementations.
+	 */
+
+	namespace execution {
+		struct sequenced_policy {};
+		struct parallel_policy {};
+
+		inline constexpr sequenced_policy seq{};
+		inline constexpr parallel_policy par{};
+	}
+
+	template <typename T>
+	struct is_execution_policy : std::bool_constant<std::is_same_v<T, execution::sequenced_policy> || std::is_same_v<T, execution::parallel_policy>> {};
+
+	template <typename T>
+	inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+
+	namespace detail {
+
+		/*!
+		 * @class	node_slab
+		 *
+		 * @brief	A block of memory split in a fixed number of equally sized slots.
+		 *
+		 * Slots are handed out in address order ( or in reverse address order for descending slabs ) and are never reused.
+		 * The block is sized lazily, by the first allocation, and released when the last reference to the slab is dropped.
+		 *
+		 * Handing out a slot is thread-safe.
+		 */
+
+		class node_slab {
+		public:
+			static node_slab* create(std::size_t slotCount, bool descending = false) {
+				return new node_slab(slotCount, descending);
+			}
+
+			node_slab(const node_slab& other) =delete;
+			node_slab& operator=(const node_slab& other) =delete;
+
+			void retain() noexcept {
+				this->references.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			void release() noexcept {
+				if (this->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					delete this;
+				}
+			}
+
+			/*!
+			 * @brief	Hands out the next free slot
+			 *
+			 * @returns	A pointer to the slot or nullptr if the slab is exhausted or the slots are too small for the request.
+			 */
+
+			void* allocate(std::size_t bytes, std::size_t alignment) {
+				std::call_once(this->storageInitialization, [this, bytes, alignment]() {
+					this->alignment = alignment;
+					this->stride = ((bytes + alignment - 1) / alignment) * alignment;
+					this->storage = static_cast<unsigned char*>(::operator new(this->stride * this->slotCount, std::align_val_t{ alignment }));
+				});
+
+				if (bytes > this->stride || alignment > this->alignment || this->nextSlot.load(std::memory_order_relaxed) >= this->slotCount) {
+					return nullptr;
+				}
+
+				std::size_t slot{ this->nextSlot.fetch_add(1, std::memory_order_relaxed) };
+				if (slot >= this->slotCount) {
+					return nullptr;
+				}
+
+				return this->storage + (this->descending ? this->slotCount - 1 - slot : slot) * this->stride;
+			}
+
+			[[nodiscard]] bool owns(const void* address) const noexcept {
+				auto byte{ static_cast<const unsigned char*>(address) };
+
+				return this->storage && !std::less<const unsigned char*>()(byte, this->storage) && std::less<const unsigned char*>()(byte, this->storage + this->stride * this->slotCount);
+			}
+
+			[[nodiscard]] std::size_t available() const noexcept {
+				std::size_t used{ this->nextSlot.load(std::memory_order_relaxed) };
+
+				return used < this->slotCount ? this->slotCount - used : 0;
+			}
+
+		private:
+			node_slab(std::size_t slotCount, bool descending) : references{ 1 }, slotCount{ slotCount }, descending{ descending } {}
+
+			~node_slab() {
+				if (this->storage) {
+					::operator delete(this->storage, std::align_val_t{ this->alignment });
+				}
+			}
+
+		private:
+			std::atomic<std::size_t> references;
+			std::atomic<std::size_t> nextSlot{ 0 };
+
+			std::size_t slotCount;
+			bool descending;
+
+			std::once_flag storageInitialization;
+			unsigned char* storage{ nullptr };
+			std::size_t stride{ 0 };
+			std::size_t alignment{ 0 };
+		};
+
+		/*!
+		 * @class	slab_allocator
+		 *
+		 * @brief	An allocator that places single objects in the slots of a node_slab.
+		 *
+		 * Every copy keeps the slab alive. Requests that the slab cannot satisfy fall back to std::allocator.
+		 * Used with std::allocate_shared, so that each node keeps its own reference count while its memory lives in the slab.
+		 *
+		 * @tparam	T	Generic type parameter.
+		 */
+
+		template <typename T>
+		class slab_allocator {
+			template <typename U>
+			friend class slab_allocator;
+
+		public:
+			using value_type = T;
+
+		public:
+			slab_allocator() noexcept : slab{ nullptr } {}
+			explicit slab_allocator(node_slab* slab) noexcept : slab{ slab } { this->retain(); }
+			slab_allocator(const slab_allocator<T>& other) noexcept : slab{ other.slab } { this->retain(); }
+			slab_allocator(slab_allocator<T>&& other) noexcept : slab{ std::exchange(other.slab, nullptr) } {}
+
+			template <typename U>
+			slab_allocator(const slab_allocator<U>& other) noexcept : slab{ other.slab } { this->retain(); }
+
+			~slab_allocator() {
+				if (this->slab) {
+					this->slab->release();
+				}
+			}
+
+			slab_allocator<T>& operator=(const slab_allocator<T>& other) noexcept {
+				slab_allocator<T> copy{ other };
+				std::swap(this->slab, copy.slab);
+
+				return *this;
+			}
+
+			slab_allocator<T>& operator=(slab_allocator<T>&& other) noexcept {
+				slab_allocator<T> moved{ std::move(other) };
+				std::swap(this->slab, moved.slab);
+
+				return *this;
+			}
+
+			[[nodiscard]] T* allocate(std::size_t count) {
+				if (this->slab && count == 1) {
+					if (void* slot{ this->slab->allocate(sizeof(T), alignof(T)) }) {
+						return static_cast<T*>(slot);
+					}
+				}
+
+				return std::allocator<T>().allocate(count);
+			}
+
+			void deallocate(T* pointer, std::size_t count) noexcept {
+				if (this->slab && this->slab->owns(pointer)) {
+					return;
+				}
+
+				std::allocator<T>().deallocate(pointer, count);
+			}
+
+			[[nodiscard]] std::size_t available() const noexcept {
+				return this->slab ? this->slab->available() : 0;
+			}
+
+			template <typename U>
+			bool operator==(const slab_allocator<U>& other) const noexcept {
+				return this->slab == other.slab;
+			}
+
+			template <typename U>
+			bool operator!=(const slab_allocator<U>& other) const noexcept {
+				return !(*this == other);
+			}
+
+		private:
+			void retain() noexcept {
+				if (this->slab) {
+					this->slab->retain();
+				}
+			}
+
+		private:
+			node_slab* slab;
+		};
+
+		/*!
+		 * @brief	Constructs a T from args, through direct initialization when T has a matching constructor and through brace initialization otherwise, as for aggregates
+		 *
+		 * The result is a prvalue, so that it initializes the object it is assigned to directly, even when T is neither copyable nor movable.
+		 */
+
+		template <typename T, typename... Args>
+		T construct_element(Args&&... args) {
+			if constexpr (std::is_constructible_v<T, Args...>) {
+				return T(std::forward<Args>(args)...);
+			} else {
+				return T{ std::forward<Args>(args)... };
+			}
+		}
+
+		/*!
+		 * @class	node_payload
+		 *
+		 * @brief	The element stored by a node of an immutable_list, either by value or, when boxed_payload<T> holds, through a shared immutable box
+		 */
+
+		template <typename T, bool Boxed = boxed_payload_v<T>>
+		class node_payload {
+		public:
+			template <typename U, typename = std::enable_if_t<!std::is_same_v<std::decay_t<U>, node_payload> && !std::is_same_v<std::decay_t<U>, std::in_place_t>>>
+			explicit node_payload(U&& value) : value{ std::forward<U>(value) } {}
+
+			template <typename... Args>
+			explicit node_payload(std::in_place_t, Args&&... args) : value(construct_element<T>(std::forward<Args>(args)...)) {}
+
+			[[nodiscard]] const T& get() const noexcept {
+				return this->value;
+			}
+
+			template <typename U>
+			void assign(U&& value) {
+				this->value = std::forward<U>(value);
+			}
+
+		private:
+			T value;
+		};
+
+		template <typename T>
+		class node_payload<T, true> {
+		public:
+			template <typename U, typename = std::enable_if_t<!std::is_same_v<std::decay_t<U>, node_payload> && !std::is_same_v<std::decay_t<U>, std::in_place_t>>>
+			explicit node_payload(U&& value) : value{ std::make_shared<const T>(std::forward<U>(value)) } {}
+
+			template <typename... Args>
+			explicit node_payload(std::in_place_t, Args&&... args) : value{ make_box(std::forward<Args>(args)...) } {}
+
+			[[nodiscard]] const T& get() const noexcept {
+				return *this->value;
+			}
+
+			template <typename U>
+			void assign(U&& value) {
+				this->value = std::make_shared<const T>(std::forward<U>(value));
+			}
+
+		private:
+			template <typename... Args>
+			static std::shared_ptr<const T> make_box(Args&&... args) {
+				if constexpr (std::is_constructible_v<T, Args...>) {
+					return std::make_shared<const T>(std::forward<Args>(args)...);
+				} else {
+					// make_shared can not brace initialize, so that aggregates are moved into the box
+					return std::make_shared<const T>(T{ std::forward<Args>(args)... });
+				}
+			}
+
+		private:
+			std::shared_ptr<const T> value;
+		};
+
+		/*!
+		 * @brief	Maps an arithmetic key to an unsigned integer of the same size whose order, as an unsigned integer, is the order of the key
+		 *
+		 * Signed integers have their sign bit flipped. Floating point numbers have all their bits flipped when negative, and their sign bit flipped otherwise.
+		 */
+
+		template <typename Key>
+		auto radix_key(Key key) noexcept {
+			static_assert(std::is_arithmetic_v<Key>, "radix_sort requires the key of an element to be of an arithmetic type");
+
+			if constexpr (std::is_floating_point_v<Key>) {
+				static_assert(sizeof(Key) == sizeof(std::uint32_t) || sizeof(Key) == sizeof(std::uint64_t), "radix_sort supports floating point keys of 32 or 64 bits");
+
+				using Bits = std::conditional_t<sizeof(Key) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+				constexpr Bits signBit{ Bits{ 1 } << (sizeof(Bits) * 8 - 1) };
+
+				Bits bits{};
+				std::memcpy(&bits, &key, sizeof(Key));
+
+				return static_cast<Bits>((bits & signBit) ? ~bits : bits | signBit);
+			} else if constexpr (std::is_signed_v<Key>) {
+				using Bits = std::make_unsigned_t<Key>;
+				constexpr Bits signBit{ static_cast<Bits>(Bits{ 1 } << (sizeof(Bits) * 8 - 1)) };
+
+				return static_cast<Bits>(static_cast<Bits>(key) ^ signBit);
+			} else {
+				return key;
+			}
+		}
+
+		/*!
+		 * @brief	Sorts the range [first, last), concurrently when policy allows it and the range is long enough
+		 *
+		 * A concurrent sort splits the range in one chunk per hardware thread, sorts each chunk in its own task
+		 * and merges the sorted chunks pairwise with std::inplace_merge, which keeps equivalent elements in order, so that a stable sort of the chunks gives a stable sort of the range.
+		 */
+
+		template <typename ExecutionPolicy, typename RandomIterator, typename Compare>
+		void sort_range(ExecutionPolicy&&, RandomIterator first, RandomIterator last, Compare comp, bool stable) {
+			// Shorter chunks are sorted faster than a task is started
+			constexpr std::size_t chunk_threshold{ 1 << 15 };
+
+			auto sortChunk{ [comp, stable](RandomIterator chunkFirst, RandomIterator chunkLast) {
+				if (stable) {
+					std::stable_sort(chunkFirst, chunkLast, comp);
+				} else {
+					std::sort(chunkFirst, chunkLast, comp);
+				}
+			} };
+
+			auto size{ static_cast<std::size_t>(last - first) };
+			auto chunkCount{ std::min<std::size_t>(std::thread::hardware_concurrency(), size / chunk_threshold) };
+			if (std::is_same_v<std::decay_t<ExecutionPolicy>, execution::sequenced_policy> || chunkCount < 2) {
+				sortChunk(first, last);
+				return;
+			}
+
+			auto chunkSize{ (size + chunkCount - 1) / chunkCount };
+			std::vector<std::future<void>> chunks{};
+			for (std::size_t chunkStart{ 0 }; chunkStart < size; chunkStart += chunkSize) {
+				chunks.push_back(std::async(std::launch::async, sortChunk, first + chunkStart, first + std::min(chunkStart + chunkSize, size)));
+			}
+
+			for (auto& chunk : chunks) {
+				chunk.get();
+			}
+
+			for (auto width{ chunkSize }; width < size; width *= 2) {
+				for (std::size_t mergeStart{ 0 }; mergeStart + width < size; mergeStart += 2 * width) {
+					std::inplace_merge(first + mergeStart, first + mergeStart + width, first + std::min(mergeStart + 2 * width, size), comp);
+				}
+			}
+		}
+	}
+
+	/*!
+	 * @struct	memory_usage
+	 *
+	 * @brief	The memory held by the nodes of one or more immutable_list versions, as reported by memory_stats
+	 *
+	 * Bytes are the size of the nodes themselves, excluding the allocator overhead and any memory owned by the elements.
+	 * Nodes placed in a slab are accounted for one by one, even though the slab is released only when all its nodes are.
+	 */
+
+	struct memory_usage {
+		// The number of distinct nodes
+		std::size_t node_count{ 0 };
+
+		// The bytes that would be released if the versions were dropped
+		std::size_t exclusive_bytes{ 0 };
+
+		// The bytes of the nodes that are also held by other lists
+		std::size_t shared_bytes{ 0 };
+
+		[[nodiscard]] std::size_t total_bytes() const noexcept {
+			return this->exclusive_bytes + this->shared_bytes;
+		}
+	};
+
+	/*!
+	 * @struct	compacted_versions
+	 *
+	 * @brief	The result of compact_versions
+	 *
+	 * @tparam	List	The type of the compacted lists.
+	 */
+
+	template <typename List>
+	struct compacted_versions {
+		// The relocated versions, in the same order as the original ones
+		std::vector<List> versions{};
+
+		// The bytes that compacting each version on its own would have spent duplicating the shared nodes
+		std::size_t bytes_saved{ 0 };
+	};
+
+	/*!
+	 * @struct	list_edit
+	 *
+	 * @brief	A single edit of a batch applied by apply_edits
+	 *
+	 * Positions are indexes in the list the batch is applied to, before any edit of the batch.
+	 *
+	 * @tparam	T	Generic type parameter.
+	 */
+
+	template <typename T>
+	struct list_edit {
+		enum class operation { insert, erase, replace };
+
+		/*!
+		 * @brief	An edit that inserts values before the element at position, or at the end of the list when position is equal to its size
+		 */
+
+		[[nodiscard]] static list_edit<T> insert(std::size_t position, T value) {
+			list_edit<T> edit{ operation::insert, position, 0, {} };
+			edit.values.push_back(std::move(value));
+
+			return edit;
+		}
+
+		/*!
+		 * @overload
+		 */
+
+		template <typename InputIterator>
+		[[nodiscard]] static list_edit<T> insert(std::size_t position, InputIterator first, InputIterator last) {
+			return list_edit<T>{ operation::insert, position, 0, std::vector<T>(first, last) };
+		}
+
+		/*!
+		 * @brief	An edit that erases the count elements starting at position
+		 */
+
+		[[nodiscard]] static list_edit<T> erase(std::size_t position, std::size_t count = 1) {
+			return list_edit<T>{ operation::erase, position, count, {} };
+		}
+
+		/*!
+		 * @brief	An edit that replaces the element at position with value
+		 */
+
+		[[nodiscard]] static list_edit<T> replace(std::size_t position, T value) {
+			list_edit<T> edit{ operation::replace, position, 1, {} };
+			edit.values.push_back(std::move(value));
+
+			return edit;
+		}
+
+		operation kind;
+		std::size_t position;
+
+		// The number of elements of the list that the edit removes
+		std::size_t count;
+
+		std::vector<T> values;
+	};
+
 	/*!
 	 * @class	immutable_list_iterator
 	 *
@@ -42,7 +537,7 @@ namespace lds {
 	public:
 		immutable_list_iterator() =default;
 		immutable_list_iterator(const immutable_list_iterator<T>& other) =default;
-		immutable_list_iterator(std::shared_ptr<typename immutable_list<T>::Node> node) : node{ node } {}
+		immutable_list_iterator(std::shared_ptr<typename immutable_list<T>::Node> node, std::size_t offset = 0) : node{ node }, offset{ offset } {}
 
 		immutable_list_iterator<T>& operator=(const immutable_list_iterator<T>& other) =default;
 	public:
@@ -61,6 +556,9 @@ namespace lds {
 
 	private:
 		std::weak_ptr<typename immutable_list<T>::Node> node;
+
+		// The position of the pointed to element inside the run represented by node
+		std::size_t offset{ 0 };
 	};
 
 	/*!
@@ -68,6 +566,11 @@ namespace lds {
 	 *
 	 * @brief	An immutable singly-linked list implementation
 	 * 
+	 * T may be move-only. Lists of move-only elements support construction from a range ( e.g trough std::move_iterator ), push_front of an rvalue,
+	 * emplace_front, pop_front and the rvalue overloads of replace_front, which never copy an element.
+	 * Modifiers that copy the elements that precede the edited position, such as insert_after and erase_after, additionally require T to be copy constructible
+	 * or boxed_payload<T> to hold.
+	 * 
 	 * @tparam	T	Generic type parameter.
 	 */
 
@@ -75,6 +578,8 @@ namespace lds {
 	class immutable_list {
 		friend class immutable_list_iterator<T>;
 
+		struct Node;
+
 	public:
 		using value_type = T;
 		using reference = value_type & ;
@@ -82,18 +587,21 @@ namespace lds {
 		using const_iterator = immutable_list_iterator<T>;
 		using size_type = std::size_t;
 
+		class transient;
+
 	public:
 
 		/*! @name Constructors
 	     */
 	     ///@{
 	      
-		immutable_list();
+		immutable_list() noexcept;
 
 		explicit immutable_list(value_type& data);
 		explicit immutable_list(value_type&& data);
 
-		immutable_list(const immutable_list<T>& other) =default;
+		immutable_list(const immutable_list<T>& other);
+		immutable_list(immutable_list<T>&& other) noexcept;
 
 		template <typename InputIterator, 
 			      typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
@@ -103,6 +611,18 @@ namespace lds {
 
 		///@}
 
+	private:
+		template <typename InputIterator>
+		immutable_list(InputIterator first, InputIterator last, std::input_iterator_tag);
+
+		template <typename ForwardIterator>
+		immutable_list(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag);
+
+		// Tags the constructor that adopts a chain of nodes, so that it never competes with the initializer_list one
+		struct node_tag {};
+
+		immutable_list(node_tag, std::shared_ptr<Node> head, size_type size) noexcept;
+
 	public:
 
 		/*!
@@ -132,7 +652,7 @@ namespace lds {
 		}
 
 		[[nodiscard]] const_iterator cend() const noexcept {
-			return const_iterator{ this->tail.lock() };
+			return const_iterator{};
 		}
 
 		///@}
@@ -156,45 +676,105 @@ namespace lds {
 		 * 
 		 * Modifiers ensures a Strong Exception Garuantee
 		 *
+		 * The rvalue overloads instead consume the list they are called on, which is left empty. They take its nodes without touching their reference counts,
+		 * and modify in place the nodes that no other list holds instead of copying them.
+		 * Other lists that share nodes with the consumed one are not affected.
+		 *
 		 */
 		///@{
 		
 		[[nodiscard]] immutable_list<T> clear() const noexcept;
 
-		[[nodiscard]] immutable_list<T> push_front(value_type& data) const;
-		[[nodiscard]] immutable_list<T> push_front(value_type&& data) const;
+		[[nodiscard]] immutable_list<T> push_front(value_type& data) const&;
+		[[nodiscard]] immutable_list<T> push_front(value_type&& data) const&;
+		[[nodiscard]] immutable_list<T> push_front(value_type& data) &&;
+		[[nodiscard]] immutable_list<T> push_front(value_type&& data) &&;
 
 		template <typename ...Args>
-		[[nodiscard]] immutable_list<T> emplace_front(Args&&... args) const;
+		[[nodiscard]] immutable_list<T> emplace_front(Args&&... args) const&;
 
-		[[nodiscard]] immutable_list<T> pop_front() const;
+		template <typename ...Args>
+		[[nodiscard]] immutable_list<T> emplace_front(Args&&... args) &&;
 
-		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, const value_type& value) const;
-		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, value_type&& value) const;
-		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, size_type count, const value_type& value) const;
-		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, std::initializer_list<T> list) const;
+		[[nodiscard]] immutable_list<T> pop_front() const&;
+		[[nodiscard]] immutable_list<T> pop_front() &&;
 
+		template <typename InputIterator,
+			      typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+		[[nodiscard]] immutable_list<T> prepend_range(InputIterator first, InputIterator last) const&;
 
-		template <typename InputIterator>
-		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, InputIterator first, InputIterator last) const;
+		template <typename InputIterator,
+			      typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+		[[nodiscard]] immutable_list<T> prepend_range(InputIterator first, InputIterator last) &&;
+
+		[[nodiscard]] immutable_list<T> prepend(std::initializer_list<T> list) const&;
+		[[nodiscard]] immutable_list<T> prepend(std::initializer_list<T> list) &&;
+
+		[[nodiscard]] immutable_list<T> replace_front(const value_type& data) const&;
+		[[nodiscard]] immutable_list<T> replace_front(value_type&& data) const&;
+		[[nodiscard]] immutable_list<T> replace_front(const value_type& data) &&;
+		[[nodiscard]] immutable_list<T> replace_front(value_type&& data) &&;
+
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, const value_type& value) const&;
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, value_type&& value) const&;
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, size_type count, const value_type& value) const&;
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, std::initializer_list<T> list) const&;
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, const value_type& value) &&;
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, value_type&& value) &&;
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, size_type count, const value_type& value) &&;
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, std::initializer_list<T> list) &&;
+
+		template <typename InputIterator,
+			      typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, InputIterator first, InputIterator last) const&;
+
+		template <typename InputIterator,
+			      typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+		[[nodiscard]] immutable_list<T> insert_after(const_iterator pos, InputIterator first, InputIterator last) &&;
 
 		template<typename... Args>
-		[[nodiscard]] immutable_list<T> emplace_after(const_iterator pos, Args&&... args) const;
+		[[nodiscard]] immutable_list<T> emplace_after(const_iterator pos, Args&&... args) const&;
 
-		[[nodiscard]] immutable_list<T> erase_after(const_iterator pos);
-		[[nodiscard]] immutable_list<T> erase_after(const_iterator first, const_iterator last);
+		template<typename... Args>
+		[[nodiscard]] immutable_list<T> emplace_after(const_iterator pos, Args&&... args) &&;
+
+		[[nodiscard]] immutable_list<T> erase_after(const_iterator pos) const&;
+		[[nodiscard]] immutable_list<T> erase_after(const_iterator first, const_iterator last) const&;
+		[[nodiscard]] immutable_list<T> erase_after(const_iterator pos) &&;
+		[[nodiscard]] immutable_list<T> erase_after(const_iterator first, const_iterator last) &&;
+
+		[[nodiscard]] immutable_list<T> take(size_type count) const;
+		[[nodiscard]] immutable_list<T> drop(size_type count) const;
+		[[nodiscard]] std::pair<immutable_list<T>, immutable_list<T>> split_at(size_type index) const;
+		[[nodiscard]] immutable_list<T> reverse() const;
 
 		///@}
 		 
 	private:
+		// A chain of new nodes, to be linked in a list
+		struct Chain {
+			std::shared_ptr<Node> head;
+			Node* tail;
+			size_type count;
+		};
+
+		[[nodiscard]] immutable_list<T> push_front_impl(std::shared_ptr<Node> node, std::false_type) const;
+		[[nodiscard]] immutable_list<T> push_front_impl(std::shared_ptr<Node> node, std::true_type);
+
+		template <typename U>
+		[[nodiscard]] immutable_list<T> replace_front_impl(U&& data, std::false_type) const;
+
 		template <typename U>
-		[[nodiscard]] immutable_list<T> push_front_impl(U&& data) const;
+		[[nodiscard]] immutable_list<T> replace_front_impl(U&& data, std::true_type);
 
 		template <typename U>
-		[[nodiscard]] immutable_list<T> insert_after_impl(const_iterator pos, size_type count, U&& value, std::true_type) const;
+		[[nodiscard]] static Chain make_chain(size_type count, U&& value, std::true_type);
 
 		template <typename InputIterator>
-		[[nodiscard]] immutable_list<T> insert_after_impl(const_iterator pos, InputIterator first, InputIterator last, std::false_type) const;
+		[[nodiscard]] static Chain make_chain(InputIterator first, InputIterator last, std::false_type);
+
+		template <typename... Args>
+		[[nodiscard]] static Chain make_chain(std::in_place_t, Args&&... args);
 
 
 	public:
@@ -210,7 +790,24 @@ namespace lds {
 
 		[[nodiscard]] constexpr size_type max_size() const noexcept;
 
+		[[nodiscard]] immutable_list<T> reserve_front(size_type count) const;
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Snapshots
+		 */
+		 ///@{
+
+		[[nodiscard]] frozen_list<T> freeze() const;
+
 		///@}
+
+	public:
+		immutable_list<T>& operator=(const immutable_list<T>& other);
+		immutable_list<T>& operator=(immutable_list<T>&& other) noexcept;
 		 
 	public: // OPERATORS
 		template <typename T>
@@ -219,125 +816,245 @@ namespace lds {
 		template <typename T>
 		friend bool operator!=(const immutable_list<T>& left, const immutable_list<T>& right);
 
+	public: // MEMORY ACCOUNTING
+		template <typename T>
+		friend memory_usage memory_stats(const immutable_list<T>& list);
+
+		template <typename InputIterator>
+		friend memory_usage memory_stats(InputIterator first, InputIterator last);
+
+		template <typename T>
+		friend double fragmentation(const immutable_list<T>& list);
+
+	public: // BATCHED EDITS
+		template <typename T>
+		friend immutable_list<T> apply_edits(const immutable_list<T>& list, const std::vector<list_edit<T>>& edits);
+
+	public: // CONCATENATION
+		template <typename T>
+		friend immutable_list<T> concat(const immutable_list<T>& left, const immutable_list<T>& right);
+
+	public: // SORTING
+		template <typename ExecutionPolicy, typename T, typename Compare>
+		friend immutable_list<T> sort(ExecutionPolicy&& policy, const immutable_list<T>& list, Compare comp);
+
+		template <typename ExecutionPolicy, typename T, typename Compare>
+		friend immutable_list<T> stable_sort(ExecutionPolicy&& policy, const immutable_list<T>& list, Compare comp);
+
+		template <typename T, typename KeyFunction>
+		friend immutable_list<T> radix_sort(const immutable_list<T>& list, KeyFunction key);
+
+	public: // COMPACTION
+		template <typename T>
+		friend immutable_list<T> compact(const immutable_list<T>& list);
+
+		template <typename InputIterator>
+		friend compacted_versions<typename std::iterator_traits<InputIterator>::value_type> compact_versions(InputIterator first, InputIterator last);
+
 	private: // HELPERS
 		const_iterator iteratorAt(size_type index) const;
 
+		template <typename ...Args>
+		[[nodiscard]] std::shared_ptr<Node> make_node(Args&&... args) const;
+
+		[[nodiscard]] immutable_list<T> path_copy(const_iterator pos, Chain inserted, const_iterator suffixStart, size_type erasedCount) const;
+		[[nodiscard]] immutable_list<T> path_update(const_iterator pos, Chain inserted, const_iterator suffixStart, size_type erasedCount);
+
+		[[nodiscard]] std::pair<std::shared_ptr<Node>, Node*> copy_prefix(const Node* first, const_iterator pos) const;
+
+		template <typename ExecutionPolicy, typename Compare>
+		[[nodiscard]] immutable_list<T> sorted(ExecutionPolicy&& policy, Compare comp, bool stable) const;
+		[[nodiscard]] std::shared_ptr<Node> suffix_from(const_iterator position) const;
+		[[nodiscard]] std::shared_ptr<Node> take_suffix(Node* last, const_iterator suffixStart);
+
+		// Whether node is the node position points to, compared by owner so that the weak reference of position is not locked
+		[[nodiscard]] static bool is_node_of(const std::shared_ptr<Node>& node, const const_iterator& position) noexcept {
+			return !node.owner_before(position.node) && !position.node.owner_before(node);
+		}
+
+		struct Snapshot {
+			std::weak_ptr<Node> head;
+			size_type size;
+			std::weak_ptr<const std::vector<T>> elements;
+		};
+
+		// The snapshots built by freeze, by the first node of the frozen list
+		struct SnapshotCache {
+			std::mutex mutex{};
+			std::unordered_map<const Node*, Snapshot> snapshots{};
+			size_type pruneAt{ 64 };
+
+			// The number of snapshots, read without the lock by the modifiers that edit nodes in place
+			std::atomic<std::size_t> count{ 0 };
+		};
+
+		[[nodiscard]] static SnapshotCache& snapshot_cache();
+		static void forget_snapshots(const Node* first, const Node* last);
+
 	private:
 		struct Node {
 		public:
-			Node() : data{}, next{} {}
+			template <typename U, typename = std::enable_if_t<!std::is_same_v<std::decay_t<U>, std::in_place_t>>>
+			explicit Node(U&& data, size_type count = 1) : data{ std::forward<U>(data) }, next{ nullptr }, count{ count } {}
 
-			template <typename U>
-			explicit Node(U&& data) : data{ std::forward<U>(data) }, next{ nullptr } {}
+			// Constructs the element directly in the node from args
+			template <typename... Args>
+			explicit Node(std::in_place_t, Args&&... args) : data{ std::in_place, std::forward<Args>(args)... }, next{ nullptr }, count{ 1 } {}
+
+			// Unlinks the uniquely owned nodes that follow this one iteratively, so that dropping a long list does not recurse once per node
+			~Node() {
+				auto following{ std::move(this->next) };
+				while (following && following.use_count() == 1) {
+					following = std::move(following->next);
+				}
+			}
 
 		public:
-			value_type data;
+			detail::node_payload<value_type> data;
 			std::shared_ptr<Node> next;
+
+			// The number of consecutive elements of the list that the node represents, all equal to data
+			size_type count;
 		};
 
+		// Lists with up to this number of elements are not worth a slab, which costs two allocations
+		static constexpr size_type slab_threshold{ 2 };
+
+		// Whether a node can be copied, which the modifiers that edit the list after its first element require
+		static constexpr bool copyable_payload{ std::is_copy_constructible_v<T> || boxed_payload_v<T> };
+
 		std::shared_ptr<Node> head;
-		std::weak_ptr<Node> tail;
 		size_type m_size;
+
+		detail::slab_allocator<Node> reservation;
 	};
 	 
 	/*!
 	 * @brief	Default constructor
 	 *
+	 * An empty list owns no node, so that it does not allocate.
+	 *
 	 * @tparam	T	Generic type parameter.
 	 */
 
 	template <typename T>
-	inline immutable_list<T>::immutable_list() : head{ std::make_shared<Node>() }, tail{ head }, m_size{ 0 } {}
+	inline immutable_list<T>::immutable_list() noexcept : head{}, m_size{ 0 } {}
 
 	/*!
 	 * @brief	Constructs a single-element list with containing the passed in data
 	 *
+	 * Performs a single allocation.
+	 *
 	 * @tparam	T	Generic type parameter.
 	 * @param	data	The data for the single element of the list
 	 */
 
 	template <typename T>
-	inline immutable_list<T>::immutable_list(value_type& data) : head{ std::make_shared<Node>(data) }, m_size{ 1 } { 
-		this->head->next = std::make_shared<Node>(); 
-		tail = this->head->next; 
-	}
+	inline immutable_list<T>::immutable_list(value_type& data) : head{ std::make_shared<Node>(data) }, m_size{ 1 } {}
 
 	/*!
 	 * @overload
 	 */
 
 	template <typename T>
-	inline immutable_list<T>::immutable_list(value_type&& data) : head{ std::make_shared<Node>(std::move(data)) }, m_size{ 1 } {
-		this->head->next = std::make_shared<Node>();
-		tail = this->head->next;
-	}
+	inline immutable_list<T>::immutable_list(value_type&& data) : head{ std::make_shared<Node>(std::move(data)) }, m_size{ 1 } {}
 
 	/*!
-	 * @brief	Constructs a new list from the content of the range [first, last)
-	 * 			
-	 * The range must be valid and last must be reachable from first.
-	 * An empty range (first == last) creates an empty list.
-	 * 
-	 * immutable_lists created in this way do not share memory. It is ineffiecient to copy a whole list trough its iterators, if such
-	 * a beahviour is needed, use the copy constructor for better performance.
-	 * 
-	 * This overloads participate in overload resolution only if InputIterator satisfies the LegacyInputIterator concept.
+	 * @brief	Copy constructor
+	 *
+	 * The new list shares all the nodes of other.
 	 *
 	 * @tparam	T	Generic type parameter.
-	 * @param	first	The first element of the range
-	 * @param	last 	The last element of the range
 	 */
 
 	template <typename T>
-	template <typename InputIterator, typename >
-	inline immutable_list<T>::immutable_list(InputIterator first, InputIterator last)
-	{   //TODO: Find a better solution to abstract away the difference between an empty range and a range with one or more elements
-		//TODO: Find a more elegant solution
-		if (first == last) {
-			this->head = std::make_shared<Node>();
-			this->tail = this->head;
-			this->m_size = 0;
-			return;
-		}
+	inline immutable_list<T>::immutable_list(const immutable_list<T>& other)
+		: head{ other.head }, m_size{ other.m_size }, reservation{ other.reservation } {}
+
+	/*!
+	 * @brief	Move constructor
+	 *
+	 * The new list takes the nodes of other without touching their reference counts.
+	 * other is left empty.
+	 *
+	 * @tparam	T	Generic type parameter.
+	 */
+
+	template <typename T>
+	inline immutable_list<T>::immutable_list(immutable_list<T>&& other) noexcept
+		: head{ std::move(other.head) }, m_size{ std::exchange(other.m_size, 0) }, reservation{ std::move(other.reservation) } {}
+
+	/*!
+	 * @brief	Constructs a new list from the content of the range [first, last)
+	 * 			
+	 * The range must be valid and last must be reachable from first.
+	 * An empty range (first == last) creates an empty list.
+	 * 
+	 * immutable_lists created in this way do not share memory. It is ineffiecient to copy a whole list trough its iterators, if such
+	 * a beahviour is needed, use the copy constructor for better performance.
+	 * 
+	 * When InputIterator satisfies the LegacyForwardIterator concept, all the nodes of the new list are allocated in a single contiguous slab,
+	 * laid out in traversal order, unless the list is so short that the slab would not save any allocation. Each node is still reference counted on its own, so that the list can be shared by the lists that are generated from it,
+	 * but the slab is released only when none of its nodes is alive anymore.
+	 * 
+	 * This overloads participate in overload resolution only if InputIterator satisfies the LegacyInputIterator concept.
+	 *
+	 * @tparam	T	Generic type parameter.
+	 * @param	first	The first element of the range
+	 * @param	last 	The last element of the range
+	 */
 
-		this->head = std::make_shared<Node>(*first);
-		this->m_size = 1;
+	template <typename T>
+	template <typename InputIterator, typename >
+	inline immutable_list<T>::immutable_list(InputIterator first, InputIterator last) 
+		: immutable_list(first, last, typename std::iterator_traits<InputIterator>::iterator_category{}) {}
 
-		Node* currentNode = this->head.get();
-		while (++first != last) {
-			currentNode->next = std::make_shared<Node>(*first);
-			currentNode = currentNode->next.get();
+	template <typename T>
+	template <typename InputIterator>
+	inline immutable_list<T>::immutable_list(InputIterator first, InputIterator last, std::input_iterator_tag)
+		: head{}, m_size{ 0 }
+	{
+		std::shared_ptr<Node>* link{ &this->head };
+		for (; first != last; ++first, ++this->m_size) {
+			*link = std::make_shared<Node>(*first);
+			link = &(*link)->next;
+		}
+	}
 
-			++this->m_size;
+	template <typename T>
+	template <typename ForwardIterator>
+	inline immutable_list<T>::immutable_list(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag)
+		: head{}, m_size{ static_cast<size_type>(std::distance(first, last)) }
+	{
+		detail::slab_allocator<Node> allocator{};
+		if (this->m_size > slab_threshold) {
+			auto slab{ detail::node_slab::create(this->m_size) };
+			allocator = detail::slab_allocator<Node>(slab);
+			slab->release();
 		}
 
-		currentNode->next = std::make_shared<Node>();
-		this->tail = currentNode->next;
+		std::shared_ptr<Node>* link{ &this->head };
+		for (; first != last; ++first) {
+			*link = std::allocate_shared<Node>(allocator, *first);
+			link = &(*link)->next;
+		}
 	}
 
 	/*!
 	 * @brief	Constructs a new list from the contents of the initializer_list
 	 *
+	 * The nodes of the new list are allocated in a single contiguous slab.
+	 *
 	 * @tparam	T	Generic type parameter.
 	 * @param	list	Initializer_list to initialize the elements of the list with
 	 */
 
 	template<typename T>
-	inline immutable_list<T>::immutable_list(std::initializer_list<T> list)
-	{
-		this->head = std::make_shared<Node>();
-		this->tail = this->head;
-
-		auto lastElement{ std::rend(list) };
-		for (auto element{ std::rbegin(list) }; element != lastElement ; ++element) {
-			auto node{ std::make_shared<Node>(*element) };
-			node->next = this->head;
-
-			this->head = node;
-		}
+	inline immutable_list<T>::immutable_list(std::initializer_list<T> list) : immutable_list(list.begin(), list.end()) {}
 
-		this->m_size = list.size();
-	}
+	template<typename T>
+	inline immutable_list<T>::immutable_list(node_tag, std::shared_ptr<typename immutable_list<T>::Node> head, size_type size) noexcept
+		: head{ std::move(head) }, m_size{ size } {}
 
 	/*!
 	 * @brief	Gets the first element of the container
@@ -352,7 +1069,7 @@ namespace lds {
 	template<typename T>
 	typename inline immutable_list<T>::const_reference immutable_list<T>::front() const
 	{
-		return this->head->data;
+		return this->head->data.get();
 	}
 
 	/*!
@@ -409,6 +1126,8 @@ namespace lds {
 	 * @brief	Generates a new list with an element prepended to it
 	 * 			
 	 * 			Does not make a copy of the whole list.
+	 * 			
+	 * 			When called on an rvalue, the new list takes the nodes of this list instead of sharing them, which is left empty.
 	 *
 	 * @tparam	T	Generic type parameter.
 	 * @param [in,out]	data	The data to prepend.
@@ -417,9 +1136,9 @@ namespace lds {
 	 */
 
 	template<typename T>
-	inline immutable_list<T> immutable_list<T>::push_front(value_type& data) const
+	inline immutable_list<T> immutable_list<T>::push_front(value_type& data) const&
 	{
-		return this->push_front_impl(data);
+		return this->push_front_impl(this->make_node(data), std::false_type());
 	}
 
 	/*!
@@ -427,20 +1146,53 @@ namespace lds {
 	 */
 
 	template<typename T>
-	inline immutable_list<T> immutable_list<T>::push_front(value_type&& data) const
+	inline immutable_list<T> immutable_list<T>::push_front(value_type&& data) const&
 	{
-		return this->push_front_impl(std::move(data));
+		return this->push_front_impl(this->make_node(std::move(data)), std::false_type());
 	}
 
+	/*!
+	 * @overload
+	 */
+
 	template<typename T>
-	template<typename U>
-	inline immutable_list<T> immutable_list<T>::push_front_impl(U && data) const
+	inline immutable_list<T> immutable_list<T>::push_front(value_type& data) &&
+	{
+		return this->push_front_impl(this->make_node(data), std::true_type());
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::push_front(value_type&& data) &&
+	{
+		return this->push_front_impl(this->make_node(std::move(data)), std::true_type());
+	}
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::push_front_impl(std::shared_ptr<Node> node, std::false_type) const
+	{
+		node->next = this->head;
+
+		immutable_list<T> newList(node_tag{}, std::move(node), 1 + this->m_size);
+		if (this->reservation.available()) {
+			newList.reservation = this->reservation;
+		}
+
+		return newList;
+	}
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::push_front_impl(std::shared_ptr<Node> node, std::true_type)
 	{
-		immutable_list<T> newList{ std::forward<U>(data) };
+		node->next = std::move(this->head);
 
-		newList.head->next = this->head;
-		newList.tail = this->tail.lock();
-		newList.m_size = 1 + this->m_size;
+		immutable_list<T> newList(node_tag{}, std::move(node), 1 + std::exchange(this->m_size, 0));
+		if (this->reservation.available()) {
+			newList.reservation = std::move(this->reservation);
+		}
 
 		return newList;
 	}
@@ -448,7 +1200,8 @@ namespace lds {
 	/*!
 	 * @brief Generates a new list with an element prepended to it
 	 *
-	 * The element is constructed in place trough brace initialization.
+	 * The element is constructed in place in the new node, trough direct initialization when T has a constructor that accepts args
+	 * and trough brace initialization otherwise, so that T does not need to be movable.
 	 * Does not make a copy of the whole list.
 	 *
 	 * @tparam	T		Generic type parameter
@@ -460,21 +1213,27 @@ namespace lds {
 
 	template <typename T>
 	template <typename ...Args>
-	inline immutable_list<T> immutable_list<T>::emplace_front(Args&&... args) const {
-		// TODO: check if there is a sense in trying a variadic emplace constructor
-		immutable_list<T> newList{ T{std::forward<Args>(args)...} };
+	inline immutable_list<T> immutable_list<T>::emplace_front(Args&&... args) const& {
+		return this->push_front_impl(this->make_node(std::in_place, std::forward<Args>(args)...), std::false_type());
+	}
 
-		newList.head->next = this->head;
-		newList.tail = this->tail.lock();
-		newList.m_size = 1 + this->m_size;
+	/*!
+	 * @overload
+	 */
 
-		return newList;
+	template <typename T>
+	template <typename ...Args>
+	inline immutable_list<T> immutable_list<T>::emplace_front(Args&&... args) && {
+		return this->push_front_impl(this->make_node(std::in_place, std::forward<Args>(args)...), std::true_type());
 	}
 
 	/*!
 	 * @brief	Generates a new list with an the front element removed
 	 * 			
 	 * Does not need to copy the list.
+	 * 
+	 * When called on an rvalue, the new list takes the remaining nodes of this list, which is left empty.
+	 * A front run that is not shared with any other list is shortened in place instead of being copied, which invalidates the iterators to its elements.
 	 *
 	 * @tparam	T	Generic type parameter.
 	 *
@@ -482,40 +1241,62 @@ namespace lds {
 	 */
 
 	template<typename T>
-	inline immutable_list<T> immutable_list<T>::pop_front() const
+	inline immutable_list<T> immutable_list<T>::pop_front() const&
 	{
-		immutable_list<T> newList{};
-		newList.head = this->head->next;
-		newList.m_size = 1 - this->m_size;
+		return immutable_list<T>(node_tag{}, this->suffix_from(std::next(this->cbegin())), this->m_size - 1);
+	}
 
-		return newList;
+	/*!
+	 * @overload
+	 */
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::pop_front() &&
+	{
+		std::shared_ptr<Node> newHead{};
+		if (this->head.use_count() != 1) {
+			newHead = this->suffix_from(std::next(this->cbegin()));
+		} else if (this->head->count != 1) {
+			forget_snapshots(this->head.get(), this->head.get());
+			--this->head->count;
+			newHead = std::move(this->head);
+		} else {
+			newHead = std::move(this->head->next);
+		}
+
+		this->head.reset();
+
+		return immutable_list<T>(node_tag{}, std::move(newHead), std::exchange(this->m_size, 0) - 1);
 	}
 
 	/*!
-	 * @brief	Generates a new list with one or more elements inserted after the given position
-	 * 			
-	 * - inserts value after the element pointed to by pos  
-	 * - same as above
-	 * - inserts count copies of the value after the element pointed to by pos
-     * - inserts elements from range [first, last) after the element pointed to by pos.
-     * - inserts elements from initializer list list.
+	 * @brief	Generates a new list with the elements in the range [first, last) prepended to it, in the same order
+	 *
+	 * Equivalent to pushing the elements of the range in reverse order, without generating the intermediate lists.
+	 * When InputIterator satisfies the LegacyForwardIterator concept, the new nodes are allocated in a single slab, in traversal order.
+	 * The last new node is linked to the first node of this list, so that the whole list is shared.
+	 *
+	 * When called on an rvalue, the new list takes the nodes of this list instead of sharing them, which is left empty.
 	 *
-	 * Copies of the elements in the range [begin, pos] and (pos, end] are made.
-	 * 
 	 * @tparam	T	Generic type parameter.
-	 * @param	pos  	The position after which the new elements should be inserted. Must be a valid iterator in the range [begin, end) of this list.
-	 * @param	value	The data to insert in the new elements
-	 * @param	count	The number of elements to insert in the new list
-	 * @param	first,last	The range of elements to insert
-	 * @param	list	initializer_list to insert the values from
+	 * @param	first	The first element of the range
+	 * @param	last 	The last element of the range
 	 *
-	 * @returns	A new list with one or more elements inserted after the given position
+	 * @returns	A new list with the elements of the range prepended
 	 */
 
 	template<typename T>
-	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, const value_type& value) const
+	template<typename InputIterator, typename>
+	inline immutable_list<T> immutable_list<T>::prepend_range(InputIterator first, InputIterator last) const&
 	{
-		return this->insert_after_impl(pos, 1, value, std::true_type());
+		auto chain{ make_chain(first, last, std::false_type()) };
+		if (!chain.head) {
+			return *this;
+		}
+
+		chain.tail->next = this->head;
+
+		return immutable_list<T>(node_tag{}, std::move(chain.head), this->m_size + chain.count);
 	}
 
 	/*!
@@ -523,9 +1304,17 @@ namespace lds {
 	 */
 
 	template<typename T>
-	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, value_type&& value) const
+	template<typename InputIterator, typename>
+	inline immutable_list<T> immutable_list<T>::prepend_range(InputIterator first, InputIterator last) &&
 	{
-		return this->insert_after_impl(pos, 1, std::move(value), std::true_type());
+		auto chain{ make_chain(first, last, std::false_type()) };
+		if (!chain.head) {
+			return std::move(*this);
+		}
+
+		chain.tail->next = std::move(this->head);
+
+		return immutable_list<T>(node_tag{}, std::move(chain.head), std::exchange(this->m_size, 0) + chain.count);
 	}
 
 	/*!
@@ -533,9 +1322,9 @@ namespace lds {
 	 */
 
 	template<typename T>
-	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, size_type count, const value_type & value) const
+	inline immutable_list<T> immutable_list<T>::prepend(std::initializer_list<T> list) const&
 	{
-		return this->insert_after_impl(pos, count, value, std::true_type());
+		return this->prepend_range(list.begin(), list.end());
 	}
 
 	/*!
@@ -543,224 +1332,1837 @@ namespace lds {
 	 */
 
 	template<typename T>
-	template<typename InputIterator>
-	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, InputIterator first, InputIterator last) const
+	inline immutable_list<T> immutable_list<T>::prepend(std::initializer_list<T> list) &&
 	{
-		return this->insert_after_impl(pos, first, last, std::false_type());
+		return std::move(*this).prepend_range(list.begin(), list.end());
 	}
 
 	/*!
-	 * @overload
+	 * @brief	Generates a new list with the front element replaced by data
+	 *
+	 * Equivalent to pop_front().push_front(data), without generating the intermediate list.
+	 * 
+	 * When called on an rvalue whose front node is not shared with any other list, the node is reused and data is assigned to it in place,
+	 * so that no allocation takes place. In this case only a Basic Exception Guarantee is provided and iterators to the front element
+	 * of the moved-from list observe the new value.
+	 * Calling replace_front on an empty list is considered undefined behaviour.
+	 *
+	 * @tparam	T	Generic type parameter.
+	 * @param	data	The data for the new front element
+	 *
+	 * @returns	A new list with the front element replaced
 	 */
 
 	template<typename T>
-	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, std::initializer_list<T> list) const
+	inline immutable_list<T> immutable_list<T>::replace_front(const value_type& data) const&
 	{
-		return this->insert_after_impl(pos, list.begin(), list.end(), std::false_type());
+		return this->replace_front_impl(data, std::false_type());
 	}
 
+	/*!
+	 * @overload
+	 */
+
 	template<typename T>
-	template<typename U>
-	inline immutable_list<T> immutable_list<T>::insert_after_impl(const_iterator pos, size_type count, U&& value, std::true_type) const
+	inline immutable_list<T> immutable_list<T>::replace_front(value_type&& data) const&
 	{
-		// TODO: Benchmark a flattened out solution to remove the creation and destruction of the unused sentinel node
-		immutable_list<T> newList{ this->cbegin(), ++pos };
-		auto lastNode{ newList.iteratorAt(newList.m_size - 1).node.lock() };
-
-		// Inserts the new elements
-		for (size_type index{ 0 }; index < count; ++index) {
-			lastNode->next = std::make_shared<Node>(std::forward<U>(value) );
-			lastNode = lastNode->next;
-		}
-		lastNode->next = pos.node.lock();
-
-		// Connects back to the original list
-		newList.tail = this->tail;
-		newList.m_size += count + std::distance(pos, this->cend());
-		
-		return newList;
+		return this->replace_front_impl(std::move(data), std::false_type());
 	}
 
+	/*!
+	 * @overload
+	 */
+
 	template<typename T>
-	template<typename InputIterator>
-	inline immutable_list<T> immutable_list<T>::insert_after_impl(const_iterator pos, InputIterator first, InputIterator last, std::false_type) const
+	inline immutable_list<T> immutable_list<T>::replace_front(const value_type& data) &&
 	{
-		// TODO: Benchmark a flattened out solution to remove the creation and destruction of the unused sentinel node
-		immutable_list<T> newList{ this->cbegin(), ++pos };
-		auto lastNode{ newList.iteratorAt(newList.m_size - 1).node.lock() };
-
-		// Inserts the new elements
-		newList.m_size += std::distance(pos, this->cend()) + std::distance(first, last);
-		while(first != last) {
-			lastNode->next = std::make_shared<Node>(*first);
-			lastNode = lastNode->next;
-
-			++first;
-		}
-		
-		// Connects back to the orignal list
-		lastNode->next = pos.node.lock();
-		newList.tail = this->tail;
-
-		return newList;
+		return this->replace_front_impl(data, std::true_type());
 	}
 
 	/*!
-	 * @brief Inserts a new element after the position pos
-	 * 		 
-	 * The element is constructed in place trough brace initialization.
-	 * 
-	 * @tparam	T		Generic type parameter
-	 * @tparam	Args	Variadic type parameter
-	 * @param	pos		The position after which the new elements should be inserted. Must be a valid iterator in the range [begin, end) of this list. 
-	 * @param	args	The arguments to pass to the element constructor
-	 * 					
-	 * @returns	A new list with one element inserted after the given position
+	 * @overload
 	 */
 
 	template<typename T>
-	template<class ...Args>
-	inline immutable_list<T> immutable_list<T>::emplace_after(const_iterator pos, Args && ...args) const
+	inline immutable_list<T> immutable_list<T>::replace_front(value_type&& data) &&
 	{
-		auto newList{ immutable_list<T>(this->cbegin(), ++pos) };
-		auto lastNode{ newList.iteratorAt(newList.m_size - 1).node.lock() };
-
-		lastNode->next = std::make_shared<Node>(T{ std::forward<Args>(args)... });
-		lastNode->next->next = pos.node.lock();
-
-		newList.m_size += std::distance(pos, this->cend()) + 1;
-
-		return newList;
+		return this->replace_front_impl(std::move(data), std::true_type());
 	}
 
-	template <typename T>
-	inline immutable_list<T> immutable_list<T>::erase_after(const_iterator pos) {
-		immutable_list<T> newList{ this->cbegin(), ++pos };
-
-		auto lastElement{ newList.iteratorAt(newList.m_size - 1) };
-		lastElement.node.lock()->next = (++pos).node.lock();
-
-		newList.tail = this->tail;
-		newList.m_size += std::distance(pos, this->cend());
+	template<typename T>
+	template<typename U>
+	inline immutable_list<T> immutable_list<T>::replace_front_impl(U&& data, std::false_type) const
+	{
+		auto node{ this->make_node(std::forward<U>(data)) };
+		node->next = this->suffix_from(std::next(this->cbegin()));
 
-		return newList;
+		return immutable_list<T>(node_tag{}, std::move(node), this->m_size);
 	}
-	
-	template <typename T>
-	inline immutable_list<T> immutable_list<T>::erase_after(const_iterator first, const_iterator last) {
-		if (first == last) {
-			return *this;
-		}
 
-		auto leftList{ immutable_list<T>(this->cbegin(), ++first) };
-		auto rightList{ immutable_list<T>(last, this->cend()) };
-
-		auto lastElement{ leftList.iteratorAt(leftList.m_size - 1) };
-		lastElement.node.lock()->next = rightList.head;
+	template<typename T>
+	template<typename U>
+	inline immutable_list<T> immutable_list<T>::replace_front_impl(U&& data, std::true_type)
+	{
+		if (this->head.use_count() != 1 || this->head->count != 1) {
+			return this->replace_front_impl(std::forward<U>(data), std::false_type());
+		}
 
-		leftList.tail = rightList.tail;
-		leftList.m_size += rightList.m_size;
+		forget_snapshots(this->head.get(), this->head.get());
+		this->head->data.assign(std::forward<U>(data));
 
-		return leftList;
+		return immutable_list<T>(node_tag{}, std::move(this->head), std::exchange(this->m_size, 0));
 	}
 
 	/*!
-	 * @brief	Checks if the list is empty
+	 * @brief	Generates a new list with one or more elements inserted after the given position
+	 * 			
+	 * - inserts value after the element pointed to by pos  
+	 * - same as above
+	 * - inserts count copies of the value after the element pointed to by pos
+     * - inserts elements from range [first, last) after the element pointed to by pos.
+     * - inserts elements from initializer list list.
 	 *
+	 * Copies of the elements in the range [begin, pos] are made, while the elements in the range (pos, end) are shared with this list.
+	 * 
+	 * The count copies of value are stored only once, in a single node that represents the whole run.
+	 * Iterators expand runs transparently. A run is split only when a modifier edits the list inside of it.
+	 * 
 	 * @tparam	T	Generic type parameter.
+	 * @param	pos  	The position after which the new elements should be inserted. Must be a valid iterator in the range [begin, end) of this list.
+	 * @param	value	The data to insert in the new elements
+	 * @param	count	The number of elements to insert in the new list
+	 * @param	first,last	The range of elements to insert
+	 * @param	list	initializer_list to insert the values from
 	 *
-	 * @returns	true if the list is empty, false otherwise.
+	 * @returns	A new list with one or more elements inserted after the given position
 	 */
 
 	template<typename T>
-	inline bool immutable_list<T>::empty() const noexcept
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, const value_type& value) const&
 	{
-		return !this->m_size;
+		return this->path_copy(pos, make_chain(1, value, std::true_type()), std::next(pos), 0);
 	}
 
 	/*!
-	 * @brief	Gets the current number of elements in the list
-	 *
-	 * @tparam	T	Generic type parameter.
-	 *
-	 * @returns	The number of elements in the list
+	 * @overload
 	 */
 
 	template<typename T>
-	typename inline immutable_list<T>::size_type immutable_list<T>::size() const noexcept
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, value_type&& value) const&
 	{
-		return this->m_size;
+		return this->path_copy(pos, make_chain(1, std::move(value), std::true_type()), std::next(pos), 0);
 	}
 
 	/*!
-	 * @brief	Gets the theorethical maximum size of a list
-	 *
-	 * Generally, some kind of failure is expected before reaching the theoretical, implementation, limit ( e.g running out of memory )
-	 * 
-	 * @tparam	T	Generic type parameter.
-	 *
-	 * @returns	Maximum number of elements.
+	 * @overload
 	 */
 
 	template<typename T>
-	typename inline constexpr immutable_list<T>::size_type immutable_list<T>::max_size() const noexcept
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, size_type count, const value_type & value) const&
 	{
-		return std::numeric_limits<size_type>::max();
+		if (count == 0) {
+			return *this;
+		}
+
+		return this->path_copy(pos, make_chain(count, value, std::true_type()), std::next(pos), 0);
 	}
-	
+
+	/*!
+	 * @overload
+	 */
+
 	template<typename T>
-	typename inline immutable_list<T>::const_iterator immutable_list<T>::iteratorAt(size_type index) const
+	template<typename InputIterator, typename>
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, InputIterator first, InputIterator last) const&
 	{
-		return std::next(this->cbegin(), index);
+		return this->path_copy(pos, make_chain(first, last, std::false_type()), std::next(pos), 0);
 	}
 
-	// FRIEND FUNCTIONS
-
 	/*!
-	 * @brief	Equality operator
-	 * 			
-	 * @returns	true if the lists are equal, false otherwise
+	 * @overload
 	 */
 
 	template<typename T>
-	bool operator==(const immutable_list<T>& left, const immutable_list<T>& right)
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, std::initializer_list<T> list) const&
 	{
-		// TODO: Benchmark to see if in a tight loop preemptively exiting if the lists are of different sizes improves performance
-		return std::equal(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+		return this->path_copy(pos, make_chain(list.begin(), list.end(), std::false_type()), std::next(pos), 0);
 	}
 
 	/*!
-	 * @brief	Inequality operator
+	 * @brief	Generates a new list with one or more elements inserted after the given position, reusing the nodes of this list that no other list holds
 	 *
-	 * @returns	true if !(left == right), false otherwise
+	 * The nodes in the range [begin, pos] that are held only by this list are modified in place, while the nodes that follow the first shared one are copied as usual,
+	 * so that, when no other list shares the prefix, the only allocations are the ones for the new elements.
+	 * 
+	 * This list is left empty. Iterators to its elements remain valid as long as the new list is alive.
+	 * 
+	 * @see	insert_after(const_iterator, const value_type&) const&
 	 */
 
 	template<typename T>
-	bool operator!=(const immutable_list<T>& left, const immutable_list<T>& right)
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, const value_type& value) &&
 	{
-		return !(left == right);
+		return this->path_update(pos, make_chain(1, value, std::true_type()), std::next(pos), 0);
 	}
 
-	// IMMUTABLE_LIST_ITERATOR IMPLEMENTATION //
+	/*!
+	 * @overload
+	 */
 
 	template<typename T>
-	inline bool operator==(const immutable_list_iterator<T>& left, const immutable_list_iterator<T>& right) noexcept
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, value_type&& value) &&
 	{
-		return left.node.lock() == right.node.lock();
+		return this->path_update(pos, make_chain(1, std::move(value), std::true_type()), std::next(pos), 0);
 	}
 
+	/*!
+	 * @overload
+	 */
+
 	template<typename T>
-	inline bool operator!=(const immutable_list_iterator<T>& left, const immutable_list_iterator<T>& right) noexcept
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, size_type count, const value_type & value) &&
 	{
-		return !(left == right);
+		if (count == 0) {
+			return immutable_list<T>(node_tag{}, std::move(this->head), std::exchange(this->m_size, 0));
+		}
+
+		return this->path_update(pos, make_chain(count, value, std::true_type()), std::next(pos), 0);
 	}
 
+	/*!
+	 * @overload
+	 */
+
 	template<typename T>
-	inline immutable_list_iterator<T>& immutable_list_iterator<T>::operator++()
+	template<typename InputIterator, typename>
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, InputIterator first, InputIterator last) &&
 	{
-		this->node = this->node.lock()->next;
-
-		return *this;
+		return this->path_update(pos, make_chain(first, last, std::false_type()), std::next(pos), 0);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::insert_after(const_iterator pos, std::initializer_list<T> list) &&
+	{
+		return this->path_update(pos, make_chain(list.begin(), list.end(), std::false_type()), std::next(pos), 0);
+	}
+
+	/*!
+	 * @brief	Creates the chain of count elements equal to value
+	 *
+	 * The copies are represented by a single run.
+	 */
+
+	template<typename T>
+	template<typename U>
+	typename inline immutable_list<T>::Chain immutable_list<T>::make_chain(size_type count, U&& value, std::true_type)
+	{
+		auto run{ std::make_shared<Node>(std::forward<U>(value), count) };
+		auto runTail{ run.get() };
+
+		return Chain{ std::move(run), runTail, count };
+	}
+
+	/*!
+	 * @brief	Creates the chain of the elements in the range [first, last)
+	 *
+	 * When InputIterator satisfies the LegacyForwardIterator concept, the nodes are allocated in a single slab, in traversal order, as for the range constructor.
+	 */
+
+	template<typename T>
+	template<typename InputIterator>
+	typename inline immutable_list<T>::Chain immutable_list<T>::make_chain(InputIterator first, InputIterator last, std::false_type)
+	{
+		detail::slab_allocator<Node> allocator{};
+		if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>) {
+			auto count{ static_cast<size_type>(std::distance(first, last)) };
+			if (count > slab_threshold) {
+				auto slab{ detail::node_slab::create(count) };
+				allocator = detail::slab_allocator<Node>(slab);
+				slab->release();
+			}
+		}
+
+		Chain chain{ nullptr, nullptr, 0 };
+		for (std::shared_ptr<Node>* link{ &chain.head }; first != last; ++first, ++chain.count) {
+			*link = std::allocate_shared<Node>(allocator, *first);
+			chain.tail = link->get();
+			link = &chain.tail->next;
+		}
+
+		return chain;
+	}
+
+	/*!
+	 * @brief	Creates the chain of a single element constructed in place from args
+	 */
+
+	template<typename T>
+	template<typename... Args>
+	typename inline immutable_list<T>::Chain immutable_list<T>::make_chain(std::in_place_t, Args&&... args)
+	{
+		auto node{ std::make_shared<Node>(std::in_place, std::forward<Args>(args)...) };
+		auto nodeTail{ node.get() };
+
+		return Chain{ std::move(node), nodeTail, 1 };
+	}
+
+	/*!
+	 * @brief Inserts a new element after the position pos
+	 * 		 
+	 * The element is constructed in place in the new node, as for emplace_front.
+	 * The rvalue overload reuses the nodes of this list that no other list holds, as the rvalue overloads of insert_after do.
+	 * 
+	 * @tparam	T		Generic type parameter
+	 * @tparam	Args	Variadic type parameter
+	 * @param	pos		The position after which the new elements should be inserted. Must be a valid iterator in the range [begin, end) of this list. 
+	 * @param	args	The arguments to pass to the element constructor
+	 * 					
+	 * @returns	A new list with one element inserted after the given position
+	 */
+
+	template<typename T>
+	template<class ...Args>
+	inline immutable_list<T> immutable_list<T>::emplace_after(const_iterator pos, Args && ...args) const&
+	{
+		return this->path_copy(pos, make_chain(std::in_place, std::forward<Args>(args)...), std::next(pos), 0);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template<typename T>
+	template<class ...Args>
+	inline immutable_list<T> immutable_list<T>::emplace_after(const_iterator pos, Args && ...args) &&
+	{
+		return this->path_update(pos, make_chain(std::in_place, std::forward<Args>(args)...), std::next(pos), 0);
+	}
+
+	/*!
+	 * @brief	Generates a new list with the element after pos, or the elements in the range (first, last), removed
+	 *
+	 * The rvalue overloads reuse the nodes of this list that no other list holds, as the rvalue overloads of insert_after do.
+	 */
+
+	template <typename T>
+	inline immutable_list<T> immutable_list<T>::erase_after(const_iterator pos) const& {
+		return this->path_copy(pos, Chain{ nullptr, nullptr, 0 }, std::next(pos, 2), 1);
+	}
+	
+	/*!
+	 * @overload
+	 */
+
+	template <typename T>
+	inline immutable_list<T> immutable_list<T>::erase_after(const_iterator first, const_iterator last) const& {
+		if (first == last) {
+			return *this;
+		}
+
+		// Only the erased range is walked to count the erased elements
+		auto erasedCount{ static_cast<size_type>(std::distance(first, last)) - 1 };
+
+		return this->path_copy(first, Chain{ nullptr, nullptr, 0 }, last, erasedCount);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template <typename T>
+	inline immutable_list<T> immutable_list<T>::erase_after(const_iterator pos) && {
+		return this->path_update(pos, Chain{ nullptr, nullptr, 0 }, std::next(pos, 2), 1);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template <typename T>
+	inline immutable_list<T> immutable_list<T>::erase_after(const_iterator first, const_iterator last) && {
+		if (first == last) {
+			return immutable_list<T>(node_tag{}, std::move(this->head), std::exchange(this->m_size, 0));
+		}
+
+		auto erasedCount{ static_cast<size_type>(std::distance(first, last)) - 1 };
+
+		return this->path_update(first, Chain{ nullptr, nullptr, 0 }, last, erasedCount);
+	}
+
+	/*!
+	 * @brief	Generates a new list made of the first count elements of this list
+	 *
+	 * The nodes of the first count elements are copied in a single pass, while the rest of the list is not visited.
+	 * Unlike split_at, no node is allocated for the rest of a run that contains the last kept element.
+	 * 
+	 * Requires T to be copy constructible or boxed_payload<T> to hold.
+	 *
+	 * @param	count	The number of elements to keep. A count greater than the size of the list keeps all the elements.
+	 *
+	 * @returns	A new list with the first count elements of this list
+	 */
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::take(size_type count) const
+	{
+		if (count == 0) {
+			return immutable_list<T>{};
+		}
+
+		if (count >= this->m_size) {
+			return *this;
+		}
+
+		auto prefix{ this->copy_prefix(this->head.get(), std::next(this->cbegin(), count - 1)) };
+
+		return immutable_list<T>(node_tag{}, std::move(prefix.first), count);
+	}
+
+	/*!
+	 * @brief	Generates a new list made of the elements of this list after the first count ones
+	 *
+	 * The new list shares all its nodes with this list, so that, at most, a single node is allocated to split a run.
+	 *
+	 * @param	count	The number of elements to remove. A count greater than the size of the list removes all the elements.
+	 *
+	 * @returns	A new list without the first count elements of this list
+	 */
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::drop(size_type count) const
+	{
+		if (count >= this->m_size) {
+			return immutable_list<T>{};
+		}
+
+		return immutable_list<T>(node_tag{}, this->suffix_from(std::next(this->cbegin(), count)), this->m_size - count);
+	}
+
+	/*!
+	 * @brief	Splits the list in the list of its first index elements and the list of the following ones
+	 *
+	 * Equivalent to { take(index), drop(index) }, with a single walk of the first index elements.
+	 * The first list copies its nodes, while the second one shares all its nodes with this list.
+	 *
+	 * Requires T to be copy constructible or boxed_payload<T> to hold.
+	 *
+	 * @param	index	The position of the first element of the second list
+	 *
+	 * @returns	The pair made of the list of the elements in [0, index) and the list of the elements in [index, size)
+	 */
+
+	template<typename T>
+	inline std::pair<immutable_list<T>, immutable_list<T>> immutable_list<T>::split_at(size_type index) const
+	{
+		if (index == 0) {
+			return { immutable_list<T>{}, *this };
+		}
+
+		if (index >= this->m_size) {
+			return { *this, immutable_list<T>{} };
+		}
+
+		auto last{ std::next(this->cbegin(), index - 1) };
+		auto prefix{ this->copy_prefix(this->head.get(), last) };
+
+		return { immutable_list<T>(node_tag{}, std::move(prefix.first), index), immutable_list<T>(node_tag{}, this->suffix_from(std::next(last)), this->m_size - index) };
+	}
+
+	/*!
+	 * @brief	Generates a new list with the elements of this list in reverse order
+	 *
+	 * The nodes are copied in a single slab, laid out in the traversal order of the new list, and runs are kept as runs.
+	 * As a run is copied as a single node, the slab is sized with a first walk that counts the nodes.
+	 *
+	 * Requires T to be copy constructible or boxed_payload<T> to hold.
+	 *
+	 * @returns	A new list with the same elements in reverse order
+	 */
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::reverse() const
+	{
+		static_assert(copyable_payload, "reverse copies all the elements of the list, which requires T to be copy constructible or boxed_payload<T> to hold");
+
+		size_type nodeCount{ 0 };
+		for (const Node* current{ this->head.get() }; current; current = current->next.get()) {
+			++nodeCount;
+		}
+
+		// A descending slab places each node before the one that was prepended earlier
+		detail::slab_allocator<Node> allocator{};
+		if (nodeCount > slab_threshold) {
+			auto slab{ detail::node_slab::create(nodeCount, true) };
+			allocator = detail::slab_allocator<Node>(slab);
+			slab->release();
+		}
+
+		std::shared_ptr<Node> reversed{};
+		for (const Node* current{ this->head.get() }; current; current = current->next.get()) {
+			auto node{ std::allocate_shared<Node>(allocator, current->data, current->count) };
+			node->next = std::move(reversed);
+			reversed = std::move(node);
+		}
+
+		return immutable_list<T>(node_tag{}, std::move(reversed), this->m_size);
+	}
+
+	/*!
+	 * @brief	Checks if the list is empty
+	 *
+	 * @tparam	T	Generic type parameter.
+	 *
+	 * @returns	true if the list is empty, false otherwise.
+	 */
+
+	template<typename T>
+	inline bool immutable_list<T>::empty() const noexcept
+	{
+		return !this->m_size;
+	}
+
+	/*!
+	 * @brief	Gets the current number of elements in the list
+	 *
+	 * @tparam	T	Generic type parameter.
+	 *
+	 * @returns	The number of elements in the list
+	 */
+
+	template<typename T>
+	typename inline immutable_list<T>::size_type immutable_list<T>::size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	/*!
+	 * @brief	Gets the theorethical maximum size of a list
+	 *
+	 * Generally, some kind of failure is expected before reaching the theoretical, implementation, limit ( e.g running out of memory )
+	 * 
+	 * @tparam	T	Generic type parameter.
+	 *
+	 * @returns	Maximum number of elements.
+	 */
+
+	template<typename T>
+	typename inline constexpr immutable_list<T>::size_type immutable_list<T>::max_size() const noexcept
+	{
+		return std::numeric_limits<size_type>::max();
+	}
+	
+	/*!
+	 * @brief	Generates a new list, equal to this one, that reserves memory for the next count elements prepended to it
+	 *
+	 * The memory for count nodes is allocated upfront as a single contiguous slab.
+	 * The reservation is carried over to the lists generated by push_front and emplace_front, whose new nodes take the reserved slots
+	 * without calling the allocator, until the reservation is exhausted.
+	 * 
+	 * Slots are handed out from the highest address down, so that a list built by count successive push_front traverses its new nodes in increasing address order.
+	 *
+	 * Every list that carries the same reservation draws from it. Drawing is thread-safe.
+	 * The reserved memory is released when no list carries the reservation anymore and none of the nodes placed in it is alive.
+	 *
+	 * @tparam	T	Generic type parameter.
+	 * @param	count	The number of nodes to reserve memory for
+	 *
+	 * @returns	A new list, equal to this one, that carries the reservation
+	 */
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::reserve_front(size_type count) const
+	{
+		immutable_list<T> newList(*this);
+
+		auto slab{ detail::node_slab::create(count, true) };
+		newList.reservation = detail::slab_allocator<Node>(slab);
+		slab->release();
+
+		return newList;
+	}
+
+	/*!
+	 * @brief	Gets a snapshot of the list, with its elements stored contiguously
+	 *
+	 * The snapshot is cached by the first node of the list, so that, as long as a frozen_list of it is alive, later calls on the list or on its copies
+	 * do not copy the elements again. Lists generated from this one by a modifier have a different first node and do not share the snapshot,
+	 * and the modifiers called on an rvalue list drop the snapshots of the nodes they edit in place.
+	 * The cache lives outside of the list, so that it costs nothing to lists that are never frozen.
+	 * 
+	 * Requires T to be copy constructible.
+	 *
+	 * @tparam	T	Generic type parameter.
+	 *
+	 * @returns	A frozen_list with the elements of this list
+	 */
+
+	template<typename T>
+	inline frozen_list<T> immutable_list<T>::freeze() const
+	{
+		if (!this->head) {
+			return frozen_list<T>(std::make_shared<const std::vector<T>>());
+		}
+
+		auto& cache{ snapshot_cache() };
+		{
+			std::lock_guard<std::mutex> lock{ cache.mutex };
+
+			auto snapshot{ cache.snapshots.find(this->head.get()) };
+			if (snapshot != cache.snapshots.end() && !snapshot->second.head.expired() && snapshot->second.size == this->m_size) {
+				if (auto elements{ snapshot->second.elements.lock() }) {
+					return frozen_list<T>(std::move(elements));
+				}
+			}
+		}
+
+		auto elements{ std::make_shared<const std::vector<T>>(this->cbegin(), this->cend()) };
+
+		std::lock_guard<std::mutex> lock{ cache.mutex };
+
+		// Drops the snapshots of the lists that were destroyed whenever the cache doubles in size
+		if (cache.snapshots.size() >= cache.pruneAt) {
+			for (auto snapshot{ cache.snapshots.begin() }; snapshot != cache.snapshots.end();) {
+				snapshot = (snapshot->second.head.expired() || snapshot->second.elements.expired()) ? cache.snapshots.erase(snapshot) : std::next(snapshot);
+			}
+			cache.pruneAt = std::max(cache.pruneAt, 2 * cache.snapshots.size());
+		}
+
+		cache.snapshots[this->head.get()] = Snapshot{ this->head, this->m_size, elements };
+		cache.count.store(cache.snapshots.size(), std::memory_order_release);
+
+		return frozen_list<T>(std::move(elements));
+	}
+
+	/*!
+	 * @brief	Gets the cache of the snapshots built by freeze, shared by all the lists of T
+	 */
+
+	template<typename T>
+	typename inline immutable_list<T>::SnapshotCache& immutable_list<T>::snapshot_cache()
+	{
+		static SnapshotCache cache{};
+
+		return cache;
+	}
+
+	/*!
+	 * @brief	Drops the snapshots of the lists that start at a node of the chain [first, last], before the nodes are edited in place
+	 *
+	 * A node held by a single list may still have a snapshot, built for a list that started at it and was destroyed since.
+	 * The lock is not taken while no snapshot is cached.
+	 */
+
+	template<typename T>
+	inline void immutable_list<T>::forget_snapshots(const Node* first, const Node* last)
+	{
+		auto& cache{ snapshot_cache() };
+		if (cache.count.load(std::memory_order_acquire) == 0) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock{ cache.mutex };
+		for (const Node* node{ first }; ; node = node->next.get()) {
+			cache.snapshots.erase(node);
+			if (node == last) {
+				break;
+			}
+		}
+		cache.count.store(cache.snapshots.size(), std::memory_order_release);
+	}
+
+	/*!
+	 * @brief	Copy assignment operator
+	 *
+	 * @tparam	T	Generic type parameter.
+	 */
+
+	template<typename T>
+	inline immutable_list<T>& immutable_list<T>::operator=(const immutable_list<T>& other)
+	{
+		immutable_list<T> copy(other);
+
+		std::swap(this->head, copy.head);
+		std::swap(this->m_size, copy.m_size);
+		std::swap(this->reservation, copy.reservation);
+
+		return *this;
+	}
+
+	/*!
+	 * @brief	Move assignment operator
+	 *
+	 * This list takes the nodes of other, which is left empty.
+	 *
+	 * @tparam	T	Generic type parameter.
+	 */
+
+	template<typename T>
+	inline immutable_list<T>& immutable_list<T>::operator=(immutable_list<T>&& other) noexcept
+	{
+		immutable_list<T> moved(std::move(other));
+
+		std::swap(this->head, moved.head);
+		std::swap(this->m_size, moved.m_size);
+		std::swap(this->reservation, moved.reservation);
+
+		return *this;
+	}
+
+	template<typename T>
+	typename inline immutable_list<T>::const_iterator immutable_list<T>::iteratorAt(size_type index) const
+	{
+		return std::next(this->cbegin(), index);
+	}
+
+	template<typename T>
+	template<typename ...Args>
+	inline std::shared_ptr<typename immutable_list<T>::Node> immutable_list<T>::make_node(Args&&... args) const
+	{
+		if (this->reservation.available()) {
+			return std::allocate_shared<Node>(this->reservation, std::forward<Args>(args)...);
+		}
+
+		return std::make_shared<Node>(std::forward<Args>(args)...);
+	}
+
+	/*!
+	 * @brief	Generates the list made of the range [begin, pos] of this list, followed by the inserted chain, followed by the range [suffixStart, end) of this list
+	 *
+	 * This is the path copy that all the modifiers that edit the list after its first element are built on.
+	 * The range [begin, pos] is copied in a single pass, the copy of pos is linked to the inserted chain, if any, and the suffix is shared.
+	 * As the size of the new list is derived from the number of inserted and erased elements, the suffix is never walked, so that the cost is linear in the length of the prefix.
+	 *
+	 * @param	pos				The last element of the copied prefix
+	 * @param	inserted		The chain to insert, whose head is nullptr to insert nothing
+	 * @param	suffixStart		The first element of the shared suffix
+	 * @param	erasedCount		The number of elements in the range (pos, suffixStart)
+	 */
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::path_copy(const_iterator pos, Chain inserted, const_iterator suffixStart, size_type erasedCount) const
+	{
+		auto [prefixHead, prefixTail] = this->copy_prefix(this->head.get(), pos);
+
+		if (inserted.head) {
+			prefixTail->next = std::move(inserted.head);
+			prefixTail = inserted.tail;
+		}
+		prefixTail->next = this->suffix_from(suffixStart);
+
+		return immutable_list<T>(node_tag{}, std::move(prefixHead), this->m_size + inserted.count - erasedCount);
+	}
+
+	/*!
+	 * @brief	As path_copy, but modifies in place the nodes of the range [begin, pos] that are held by this list alone, and leaves this list empty
+	 *
+	 * The prefix is walked while its nodes are uniquely owned. When pos is reached, it is linked to the inserted chain in place.
+	 * Otherwise, the nodes from the first shared one up to pos are copied, and the copy replaces the shared node in the owned prefix.
+	 *
+	 * Nodes are matched to pos and suffixStart by their owner, so that, when the whole path is uniquely owned, the suffix is moved out of
+	 * the erased nodes, or out of pos, and no reference count is touched.
+	 */
+
+	template<typename T>
+	inline immutable_list<T> immutable_list<T>::path_update(const_iterator pos, Chain inserted, const_iterator suffixStart, size_type erasedCount)
+	{
+		std::shared_ptr<Node>* link{ &this->head };
+		Node* owned{ nullptr };
+		while (link->use_count() == 1 && !is_node_of(*link, pos)) {
+			owned = link->get();
+			link = &owned->next;
+		}
+
+		Node* prefixTail{ nullptr };
+		std::shared_ptr<Node> suffix{};
+		if (link->use_count() == 1) {
+			forget_snapshots(this->head.get(), link->get());
+
+			prefixTail = link->get();
+			suffix = this->take_suffix(prefixTail, suffixStart);
+
+			// A run that contains pos is cut short after it, as suffix holds the rest of it
+			prefixTail->count = pos.offset + 1;
+		} else {
+			if (owned) {
+				forget_snapshots(this->head.get(), owned);
+			}
+
+			suffix = this->suffix_from(suffixStart);
+
+			auto [copyHead, copyTail] = this->copy_prefix(link->get(), pos);
+			*link = std::move(copyHead);
+			prefixTail = copyTail;
+		}
+
+		if (inserted.head) {
+			prefixTail->next = std::move(inserted.head);
+			prefixTail = inserted.tail;
+		}
+		prefixTail->next = std::move(suffix);
+
+		return immutable_list<T>(node_tag{}, std::move(this->head), std::exchange(this->m_size, 0) + inserted.count - erasedCount);
+	}
+
+	/*!
+	 * @brief	Moves out the chain that starts at suffixStart from the nodes that follow last, when they are held by this list alone
+	 *
+	 * Falls back to suffix_from, which shares the chain, when suffixStart points inside a run or a shared node precedes it.
+	 */
+
+	template<typename T>
+	inline std::shared_ptr<typename immutable_list<T>::Node> immutable_list<T>::take_suffix(Node* last, const_iterator suffixStart)
+	{
+		if (suffixStart.offset != 0) {
+			return this->suffix_from(suffixStart);
+		}
+
+		std::shared_ptr<Node>* link{ &last->next };
+		while (*link && link->use_count() == 1 && !is_node_of(*link, suffixStart)) {
+			link = &(*link)->next;
+		}
+
+		if (is_node_of(*link, suffixStart)) {
+			return std::move(*link);
+		}
+
+		return this->suffix_from(suffixStart);
+	}
+
+	/*!
+	 * @brief	Copies the nodes in the range [first, pos]
+	 *
+	 * The copy of the node pointed to by pos is cut short after pos, so that a run is split only where needed.
+	 * The next pointer of the last copied node is left empty.
+	 * When boxed_payload<T> holds, the copies share the elements of the original nodes instead of copy-constructing them.
+	 *
+	 * @returns	The first and the last node of the copy
+	 */
+
+	template<typename T>
+	inline std::pair<std::shared_ptr<typename immutable_list<T>::Node>, typename immutable_list<T>::Node*> immutable_list<T>::copy_prefix(const Node* first, const_iterator pos) const
+	{
+		static_assert(copyable_payload, "This modifier copies the elements that precede the edited position, which requires T to be copy constructible or boxed_payload<T> to hold");
+
+		auto last{ pos.node.lock() };
+		auto copyCount{ [&last, &pos](const Node* node) { return node == last.get() ? pos.offset + 1 : node->count; } };
+
+		auto prefixHead{ std::make_shared<Node>(first->data, copyCount(first)) };
+		Node* prefixTail{ prefixHead.get() };
+		for (const Node* current{ first }; current != last.get(); prefixTail = prefixTail->next.get()) {
+			current = current->next.get();
+			prefixTail->next = std::make_shared<Node>(current->data, copyCount(current));
+		}
+
+		return { std::move(prefixHead), prefixTail };
+	}
+
+	/*!
+	 * @brief	Generates the list with the elements of this list sorted by comp, sharing the longest sorted suffix of this list that the sort leaves in place
+	 *
+	 * The elements before the longest sorted suffix are sorted, and merged with the elements of the suffix that are less than the greatest of them.
+	 * Those are the only elements that are copied, in a single slab, while the rest of the suffix follows all the sorted elements and is shared.
+	 * The elements are sorted through pointers to their payload, so that each one is copied once, and a boxed element is not copied at all.
+	 */
+
+	template<typename T>
+	template<typename ExecutionPolicy, typename Compare>
+	inline immutable_list<T> immutable_list<T>::sorted(ExecutionPolicy&& policy, Compare comp, bool stable) const
+	{
+		using Payload = detail::node_payload<T>;
+
+		static_assert(copyable_payload, "Sorting copies the elements that precede the sorted suffix of the list, which requires T to be copy constructible or boxed_payload<T> to hold");
+
+		std::vector<const Payload*> elements{};
+		elements.reserve(this->m_size);
+
+		// The sorted suffix starts at the last element that is less than the one before it, which is always the first of its node
+		const std::shared_ptr<Node>* suffixNode{ &this->head };
+		size_type suffixIndex{ 0 };
+		for (const std::shared_ptr<Node>* link{ &this->head }; *link; link = &(*link)->next) {
+			const Payload* payload{ &(*link)->data };
+			if (!elements.empty() && comp(payload->get(), elements.back()->get())) {
+				suffixNode = link;
+				suffixIndex = elements.size();
+			}
+
+			elements.insert(elements.end(), (*link)->count, payload);
+		}
+
+		if (suffixIndex == 0) {
+			return *this;
+		}
+
+		auto payloadComp{ [&comp](const Payload* left, const Payload* right) { return comp(left->get(), right->get()); } };
+
+		auto suffixFirst{ elements.begin() + suffixIndex };
+		detail::sort_range(std::forward<ExecutionPolicy>(policy), elements.begin(), suffixFirst, payloadComp, stable);
+
+		auto greatest{ *(suffixFirst - 1) };
+		auto sharedFirst{ std::partition_point(suffixFirst, elements.end(), [&payloadComp, greatest](const Payload* element) { return payloadComp(element, greatest); }) };
+		std::inplace_merge(elements.begin(), suffixFirst, sharedFirst, payloadComp);
+
+		auto copiedCount{ static_cast<size_type>(sharedFirst - elements.begin()) };
+		detail::slab_allocator<Node> allocator{};
+		if (copiedCount > slab_threshold) {
+			auto slab{ detail::node_slab::create(copiedCount) };
+			allocator = detail::slab_allocator<Node>(slab);
+			slab->release();
+		}
+
+		std::shared_ptr<Node> sortedHead{};
+		std::shared_ptr<Node>* link{ &sortedHead };
+		for (auto element{ elements.begin() }; element != sharedFirst; ++element) {
+			*link = std::allocate_shared<Node>(allocator, **element);
+			link = &(*link)->next;
+		}
+
+		if (sharedFirst != elements.end()) {
+			*link = this->suffix_from(std::next(const_iterator{ *suffixNode }, sharedFirst - suffixFirst));
+		}
+
+		return immutable_list<T>(node_tag{}, std::move(sortedHead), this->m_size);
+	}
+
+	/*!
+	 * @brief	Gets a chain of nodes that represents the range [position, end)
+	 *
+	 * The chain is shared with this list, unless position points inside a run, in which case the rest of the run is copied in a new node.
+	 */
+
+	template<typename T>
+	inline std::shared_ptr<typename immutable_list<T>::Node> immutable_list<T>::suffix_from(const_iterator position) const
+	{
+		auto node{ position.node.lock() };
+		if constexpr (!copyable_payload) {
+			// Runs are built only by copying an element, so that a list of move-only elements has none
+			return node;
+		} else {
+			if (position.offset == 0) {
+				return node;
+			}
+
+			auto remainder{ std::make_shared<Node>(node->data, node->count - position.offset) };
+			remainder->next = node->next;
+
+			return remainder;
+		}
+	}
+
+	// TRANSIENT //
+
+	/*!
+	 * @class	immutable_list<T>::transient
+	 *
+	 * @brief	A mutable builder that owns its nodes and is turned into an immutable_list by persistent
+	 *
+	 * As no other list can share the nodes of a transient, they are modified in place: each operation allocates at most the node of the new element
+	 * and never copies other nodes or creates intermediate lists.
+	 * push_front and push_back are constant time, as the transient keeps a pointer to its last node.
+	 * 
+	 * persistent hands the nodes over to a new immutable_list in constant time, without copying them, and leaves the transient empty.
+	 * Iterators to a transient are valid until the element they point to is erased or persistent is called.
+	 * 
+	 * A transient is not thread-safe.
+	 *
+	 * @tparam	T	Generic type parameter.
+	 */
+
+	template <typename T>
+	class immutable_list<T>::transient {
+	public:
+		transient() noexcept : head{}, tail{ nullptr }, m_size{ 0 } {}
+		explicit transient(const immutable_list<T>& list);
+
+		transient(const transient& other) =delete;
+		transient(transient&& other) noexcept;
+
+		transient& operator=(const transient& other) =delete;
+		transient& operator=(transient&& other) noexcept;
+
+	public:
+		[[nodiscard]] const_iterator cbegin() const noexcept {
+			return const_iterator{ this->head };
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept {
+			return const_iterator{};
+		}
+
+		[[nodiscard]] bool empty() const noexcept {
+			return !this->m_size;
+		}
+
+		[[nodiscard]] size_type size() const noexcept {
+			return this->m_size;
+		}
+
+	public:
+		void push_front(const value_type& data) { this->link_front(std::make_shared<Node>(data)); }
+		void push_front(value_type&& data) { this->link_front(std::make_shared<Node>(std::move(data))); }
+
+		template <typename ...Args>
+		void emplace_front(Args&&... args) { this->link_front(std::make_shared<Node>(std::in_place, std::forward<Args>(args)...)); }
+
+		void push_back(const value_type& data) { this->link_back(std::make_shared<Node>(data)); }
+		void push_back(value_type&& data) { this->link_back(std::make_shared<Node>(std::move(data))); }
+
+		template <typename ...Args>
+		void emplace_back(Args&&... args) { this->link_back(std::make_shared<Node>(std::in_place, std::forward<Args>(args)...)); }
+
+		void insert_after(const_iterator pos, const value_type& value) { this->link_after(pos, std::make_shared<Node>(value)); }
+		void insert_after(const_iterator pos, value_type&& value) { this->link_after(pos, std::make_shared<Node>(std::move(value))); }
+
+		void pop_front();
+		void erase_after(const_iterator pos);
+
+		[[nodiscard]] immutable_list<T> persistent() noexcept;
+
+	private:
+		void link_front(std::shared_ptr<Node> node) noexcept;
+		void link_back(std::shared_ptr<Node> node) noexcept;
+		void link_after(const_iterator pos, std::shared_ptr<Node> node) noexcept;
+
+	private:
+		std::shared_ptr<Node> head;
+		Node* tail;
+		size_type m_size;
+	};
+
+	/*!
+	 * @brief	Constructs a transient with the elements of list
+	 *
+	 * As the nodes of list may be shared, they are copied, and runs are expanded to one node per element.
+	 */
+
+	template <typename T>
+	inline immutable_list<T>::transient::transient(const immutable_list<T>& list) : transient{}
+	{
+		for (auto element{ list.cbegin() }; element != list.cend(); ++element) {
+			this->push_back(*element);
+		}
+	}
+
+	template <typename T>
+	inline immutable_list<T>::transient::transient(transient&& other) noexcept
+		: head{ std::move(other.head) }, tail{ std::exchange(other.tail, nullptr) }, m_size{ std::exchange(other.m_size, 0) } {}
+
+	template <typename T>
+	typename inline immutable_list<T>::transient& immutable_list<T>::transient::operator=(transient&& other) noexcept
+	{
+		this->head = std::move(other.head);
+		this->tail = std::exchange(other.tail, nullptr);
+		this->m_size = std::exchange(other.m_size, 0);
+
+		return *this;
+	}
+
+	/*!
+	 * @brief	Removes the first element
+	 *
+	 * Calling pop_front on an empty transient is considered undefined behaviour.
+	 */
+
+	template <typename T>
+	inline void immutable_list<T>::transient::pop_front()
+	{
+		this->head = std::move(this->head->next);
+		if (--this->m_size == 0) {
+			this->tail = nullptr;
+		}
+	}
+
+	/*!
+	 * @brief	Removes the element after pos
+	 *
+	 * pos must be a valid iterator to this transient that is not the last element.
+	 */
+
+	template <typename T>
+	inline void immutable_list<T>::transient::erase_after(const_iterator pos)
+	{
+		auto node{ pos.node.lock() };
+
+		auto erased{ std::move(node->next) };
+		node->next = std::move(erased->next);
+		if (erased.get() == this->tail) {
+			this->tail = node.get();
+		}
+
+		--this->m_size;
+	}
+
+	/*!
+	 * @brief	Turns the transient into an immutable_list, in constant time
+	 *
+	 * The new list takes over the nodes of the transient, which is left empty.
+	 */
+
+	template <typename T>
+	inline immutable_list<T> immutable_list<T>::transient::persistent() noexcept
+	{
+		this->tail = nullptr;
+
+		return immutable_list<T>(node_tag{}, std::move(this->head), std::exchange(this->m_size, 0));
+	}
+
+	template <typename T>
+	inline void immutable_list<T>::transient::link_front(std::shared_ptr<Node> node) noexcept
+	{
+		if (!this->head) {
+			this->tail = node.get();
+		}
+
+		node->next = std::move(this->head);
+		this->head = std::move(node);
+		++this->m_size;
+	}
+
+	template <typename T>
+	inline void immutable_list<T>::transient::link_back(std::shared_ptr<Node> node) noexcept
+	{
+		auto last{ node.get() };
+		(this->tail ? this->tail->next : this->head) = std::move(node);
+
+		this->tail = last;
+		++this->m_size;
+	}
+
+	template <typename T>
+	inline void immutable_list<T>::transient::link_after(const_iterator pos, std::shared_ptr<Node> node) noexcept
+	{
+		auto previous{ pos.node.lock() };
+		if (previous.get() == this->tail) {
+			this->tail = node.get();
+		}
+
+		node->next = std::move(previous->next);
+		previous->next = std::move(node);
+		++this->m_size;
+	}
+
+	// FRIEND FUNCTIONS
+
+	/*!
+	 * @brief	Equality operator
+	 * 			
+	 * @returns	true if the lists are equal, false otherwise
+	 */
+
+	template<typename T>
+	bool operator==(const immutable_list<T>& left, const immutable_list<T>& right)
+	{
+		// TODO: Benchmark to see if in a tight loop preemptively exiting if the lists are of different sizes improves performance
+		return std::equal(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+	}
+
+	/*!
+	 * @brief	Inequality operator
+	 *
+	 * @returns	true if !(left == right), false otherwise
+	 */
+
+	template<typename T>
+	bool operator!=(const immutable_list<T>& left, const immutable_list<T>& right)
+	{
+		return !(left == right);
+	}
+
+	// BATCHED EDITS
+
+	/*!
+	 * @brief	Generates a new list with a batch of edits applied to it
+	 *
+	 * The edits must be sorted by position and must not overlap. An insertion at a position is ordered before an erasure or replacement at the same position.
+	 * 
+	 * The edits are applied in a single forward walk, which copies the list only up to the last edited position, a run at a time,
+	 * and shares the rest of it, so that k edits cost as much as a single edit at the farthest position.
+	 * 
+	 * Requires T to be copy constructible or boxed_payload<T> to hold.
+	 *
+	 * @exception	std::invalid_argument	Thrown when the edits are not sorted or overlap.
+	 * @exception	std::out_of_range		Thrown when an edit refers to elements that the list does not contain.
+	 *
+	 * @param	list	The list to edit
+	 * @param	edits	The edits to apply
+	 *
+	 * @returns	A new list with all the edits applied
+	 */
+
+	template<typename T>
+	inline immutable_list<T> apply_edits(const immutable_list<T>& list, const std::vector<list_edit<T>>& edits)
+	{
+		using Node = typename immutable_list<T>::Node;
+		using operation = typename list_edit<T>::operation;
+
+		static_assert(immutable_list<T>::copyable_payload, "apply_edits copies the elements that precede the last edit, which requires T to be copy constructible or boxed_payload<T> to hold");
+
+		if (edits.empty()) {
+			return list;
+		}
+
+		std::shared_ptr<Node> head{};
+		std::shared_ptr<Node>* link{ &head };
+
+		// The first element of the list that was neither copied nor skipped yet, and its index
+		std::shared_ptr<Node> node{ list.head };
+		std::size_t offset{ 0 };
+		std::size_t index{ 0 };
+
+		auto advance{ [&node, &offset, &index](std::size_t count) {
+			index += count;
+			if ((offset += count) == node->count) {
+				node = node->next;
+				offset = 0;
+			}
+		} };
+
+		auto copyUpTo{ [&](std::size_t position) {
+			while (index < position) {
+				auto taken{ std::min(node->count - offset, position - index) };
+
+				*link = std::make_shared<Node>(node->data, taken);
+				link = &(*link)->next;
+
+				advance(taken);
+			}
+		} };
+
+		auto skip{ [&](std::size_t count) {
+			while (count > 0) {
+				auto skipped{ std::min(node->count - offset, count) };
+
+				advance(skipped);
+				count -= skipped;
+			}
+		} };
+
+		auto size{ list.m_size };
+		for (const auto& edit : edits) {
+			if (edit.position < index) {
+				throw std::invalid_argument("The edits must be sorted by position and must not overlap");
+			}
+
+			if (edit.position > list.m_size || edit.count > list.m_size - edit.position) {
+				throw std::out_of_range((std::stringstream() << "The list does not contain the elements edited at index " << edit.position).str());
+			}
+
+			copyUpTo(edit.position);
+
+			if (edit.kind != operation::erase) {
+				for (const auto& value : edit.values) {
+					*link = std::make_shared<Node>(value);
+					link = &(*link)->next;
+				}
+			}
+
+			skip(edit.count);
+			size = size + (edit.kind == operation::erase ? 0 : edit.values.size()) - edit.count;
+		}
+
+		*link = list.suffix_from(typename immutable_list<T>::const_iterator{ node, offset });
+
+		return immutable_list<T>(typename immutable_list<T>::node_tag{}, std::move(head), size);
+	}
+
+	// MEMORY ACCOUNTING
+
+	/*!
+	 * @brief	Reports the memory held by the nodes of a list
+	 *
+	 * The nodes from the first one up to the first node that is also held by another list are exclusive to this list,
+	 * while that node and all the ones that follow it are shared.
+	 * 
+	 * Runs in linear time in the number of nodes.
+	 *
+	 * @returns	The number of nodes of the list, the bytes that dropping the list would release and the bytes that it shares with other lists
+	 */
+
+	template<typename T>
+	inline memory_usage memory_stats(const immutable_list<T>& list)
+	{
+		using Node = typename immutable_list<T>::Node;
+
+		memory_usage usage{};
+		bool shared{ false };
+		for (const std::shared_ptr<Node>* link{ &list.head }; *link; link = &(*link)->next) {
+			shared = shared || link->use_count() > 1;
+
+			++usage.node_count;
+			(shared ? usage.shared_bytes : usage.exclusive_bytes) += sizeof(Node);
+		}
+
+		return usage;
+	}
+
+	/*!
+	 * @brief	Reports the memory held, together, by the nodes of a set of list versions
+	 *
+	 * Each node is accounted for once, however many versions hold it.
+	 * Nodes that dropping the whole set would release are exclusive, even when more than one version of the set holds them,
+	 * while nodes that a list outside of the set also holds, directly or trough the nodes before them, are shared.
+	 * The reference count of each node is compared with the references to it from the versions and from their nodes.
+	 * The total bytes are the distinct memory held by the whole set.
+	 * 
+	 * Every node is visited at most twice.
+	 *
+	 * @tparam	InputIterator	An iterator over immutable_list versions
+	 *
+	 * @returns	The number of distinct nodes of the versions and their bytes, split between exclusive and shared ones
+	 */
+
+	template<typename InputIterator>
+	inline memory_usage memory_stats(InputIterator first, InputIterator last)
+	{
+		using Node = typename std::iterator_traits<InputIterator>::value_type::Node;
+
+		struct Visit {
+			long useCount;
+			long references;
+			bool shared;
+		};
+
+		// Maps each visited node to its reference count and to the number of references to it from the versions and from the visited nodes
+		std::unordered_map<const Node*, Visit> visited{};
+		for (; first != last; ++first) {
+			for (const std::shared_ptr<Node>* link{ &first->head }; *link; link = &(*link)->next) {
+				auto [position, inserted] = visited.emplace(link->get(), Visit{ link->use_count(), 0, false });
+				++position->second.references;
+
+				// The rest of the chain was visited trough this node already
+				if (!inserted) {
+					break;
+				}
+			}
+		}
+
+		// A node held from outside of the set keeps alive all the nodes that follow it
+		for (const auto& [node, visit] : visited) {
+			if (visit.shared || visit.useCount == visit.references) {
+				continue;
+			}
+
+			for (const Node* held{ node }; held; held = held->next.get()) {
+				auto& heldVisit{ visited.find(held)->second };
+				if (heldVisit.shared) {
+					break;
+				}
+
+				heldVisit.shared = true;
+			}
+		}
+
+		memory_usage usage{};
+		for (const auto& [node, visit] : visited) {
+			++usage.node_count;
+			(visit.shared ? usage.shared_bytes : usage.exclusive_bytes) += sizeof(Node);
+		}
+
+		return usage;
+	}
+
+	/*!
+	 * @brief	Measures how scattered in memory the nodes of a list are
+	 *
+	 * A list whose nodes are laid out contiguously in traversal order, such as a freshly built or compacted one, has a fragmentation close to the size of a node.
+	 * A list whose fragmentation is much larger is a good candidate for compact.
+	 *
+	 * @returns	The average distance, in bytes, between the addresses of successive nodes, or 0 for lists with less than two nodes
+	 */
+
+	template<typename T>
+	inline double fragmentation(const immutable_list<T>& list)
+	{
+		using Node = typename immutable_list<T>::Node;
+
+		double totalDistance{ 0.0 };
+		std::size_t steps{ 0 };
+		for (const Node* node{ list.head.get() }; node && node->next; node = node->next.get(), ++steps) {
+			auto from{ reinterpret_cast<std::uintptr_t>(node) };
+			auto to{ reinterpret_cast<std::uintptr_t>(node->next.get()) };
+
+			totalDistance += static_cast<double>(from < to ? to - from : from - to);
+		}
+
+		return steps ? totalDistance / static_cast<double>(steps) : 0.0;
+	}
+
+	// CONCATENATION
+
+	/*!
+	 * @brief	Generates the list made of the elements of left followed by the elements of right
+	 *
+	 * The nodes of left are copied, while right is shared as a whole, so that the cost is linear in the size of left alone.
+	 * 
+	 * Requires T to be copy constructible or boxed_payload<T> to hold.
+	 *
+	 * @param	left	The list whose elements come first
+	 * @param	right	The list whose elements come last
+	 *
+	 * @returns	A new list with the elements of both lists
+	 */
+
+	template<typename T>
+	inline immutable_list<T> concat(const immutable_list<T>& left, const immutable_list<T>& right)
+	{
+		if (left.empty()) {
+			return right;
+		}
+
+		if (right.empty()) {
+			return left;
+		}
+
+		auto [prefixHead, prefixTail] = left.copy_prefix(left.head.get(), std::next(left.cbegin(), left.m_size - 1));
+		prefixTail->next = right.head;
+
+		return immutable_list<T>(typename immutable_list<T>::node_tag{}, std::move(prefixHead), left.m_size + right.m_size);
+	}
+
+	// COMPACTION
+
+	/*!
+	 * @brief	Generates a list, equal to the given one, whose nodes are laid out contiguously in traversal order
+	 *
+	 * All the nodes are copied in a single slab, so that the new list shares no memory with the original one.
+	 * Runs are preserved as they are.
+	 * 
+	 * Requires T to be copy constructible or boxed_payload<T> to hold.
+	 *
+	 * @returns	The compacted list
+	 */
+
+	template<typename T>
+	inline immutable_list<T> compact(const immutable_list<T>& list)
+	{
+		using Node = typename immutable_list<T>::Node;
+
+		static_assert(immutable_list<T>::copyable_payload, "compact copies the elements of the list, which requires T to be copy constructible or boxed_payload<T> to hold");
+
+		std::size_t nodeCount{ 0 };
+		for (const Node* node{ list.head.get() }; node; node = node->next.get()) {
+			++nodeCount;
+		}
+
+		detail::slab_allocator<Node> allocator{};
+		if (nodeCount > immutable_list<T>::slab_threshold) {
+			auto slab{ detail::node_slab::create(nodeCount) };
+			allocator = detail::slab_allocator<Node>(slab);
+			slab->release();
+		}
+
+		std::shared_ptr<Node> head{};
+		std::shared_ptr<Node>* link{ &head };
+		for (const Node* node{ list.head.get() }; node; node = node->next.get()) {
+			*link = std::allocate_shared<Node>(allocator, node->data, node->count);
+			link = &(*link)->next;
+		}
+
+		return immutable_list<T>(typename immutable_list<T>::node_tag{}, std::move(head), list.m_size);
+	}
+
+	/*!
+	 * @brief	Relocates a set of list versions in a single contiguous slab, keeping each node that they share exactly once
+	 *
+	 * The nodes are ordered by heavy path decomposition of the graph formed by the versions, where the weight of a node is the number of versions that traverse it.
+	 * Starting from the end of each version, the path formed by following, at each node, the predecessor traversed by the most versions is laid out contiguously in traversal order,
+	 * heaviest paths first, so that the most traversed chains are sequential in memory and a traversal of any version jumps between paths only a logarithmic number of times.
+	 * 
+	 * The versions returned share no memory with the original ones. The slab is released only when none of the relocated nodes is alive anymore.
+	 * 
+	 * Requires T to be copy constructible or boxed_payload<T> to hold.
+	 * Runs in linear time in the number of distinct nodes, plus the sorting of the paths.
+	 *
+	 * @tparam	InputIterator	An iterator over immutable_list versions
+	 *
+	 * @returns	The relocated versions, in the same order as the given ones, and the bytes saved over compacting each of them independently
+	 */
+
+	template<typename InputIterator>
+	inline compacted_versions<typename std::iterator_traits<InputIterator>::value_type> compact_versions(InputIterator first, InputIterator last)
+	{
+		using List = typename std::iterator_traits<InputIterator>::value_type;
+		using Node = typename List::Node;
+
+		static_assert(List::copyable_payload, "compact_versions copies the elements of the lists, which requires T to be copy constructible or boxed_payload<T> to hold");
+
+		constexpr std::size_t none{ std::numeric_limits<std::size_t>::max() };
+
+		std::vector<List> originals(first, last);
+
+		// Numbers the distinct nodes, recording the number of the node that follows each one and of the first node of each version
+		std::unordered_map<const Node*, std::size_t> indexes{};
+		std::vector<const Node*> nodes{};
+		std::vector<std::size_t> nextIndexes{};
+		std::vector<std::size_t> headIndexes{};
+		for (const auto& version : originals) {
+			if (!version.head) {
+				headIndexes.push_back(none);
+			}
+
+			auto previous{ none };
+			for (const Node* node{ version.head.get() }; node; node = node->next.get()) {
+				auto [position, inserted] = indexes.emplace(node, nodes.size());
+				if (previous == none) {
+					headIndexes.push_back(position->second);
+				} else {
+					nextIndexes[previous] = position->second;
+				}
+
+				// The rest of the chain was numbered trough this node already
+				if (!inserted) {
+					break;
+				}
+
+				nodes.push_back(node);
+				nextIndexes.push_back(none);
+				previous = position->second;
+			}
+		}
+
+		// Counts the versions that traverse each node, visiting each node after all of its predecessors
+		std::vector<std::size_t> traffic(nodes.size(), 0);
+		std::vector<std::size_t> pendingPredecessors(nodes.size(), 0);
+		for (auto head : headIndexes) {
+			if (head != none) {
+				++traffic[head];
+			}
+		}
+		for (auto next : nextIndexes) {
+			if (next != none) {
+				++pendingPredecessors[next];
+			}
+		}
+
+		std::vector<std::size_t> ready{};
+		for (std::size_t index{ 0 }; index < nodes.size(); ++index) {
+			if (!pendingPredecessors[index]) {
+				ready.push_back(index);
+			}
+		}
+
+		while (!ready.empty()) {
+			auto index{ ready.back() };
+			ready.pop_back();
+
+			auto next{ nextIndexes[index] };
+			if (next != none) {
+				traffic[next] += traffic[index];
+				if (!--pendingPredecessors[next]) {
+					ready.push_back(next);
+				}
+			}
+		}
+
+		// Finds the heaviest predecessor of each node, and the last node of each heavy path
+		std::vector<std::size_t> heavyPredecessors(nodes.size(), none);
+		for (std::size_t index{ 0 }; index < nodes.size(); ++index) {
+			auto next{ nextIndexes[index] };
+			if (next != none && (heavyPredecessors[next] == none || traffic[index] > traffic[heavyPredecessors[next]])) {
+				heavyPredecessors[next] = index;
+			}
+		}
+
+		std::vector<std::size_t> pathEnds{};
+		for (std::size_t index{ 0 }; index < nodes.size(); ++index) {
+			if (nextIndexes[index] == none || heavyPredecessors[nextIndexes[index]] != index) {
+				pathEnds.push_back(index);
+			}
+		}
+		std::stable_sort(pathEnds.begin(), pathEnds.end(), [&traffic](std::size_t left, std::size_t right) { return traffic[left] > traffic[right]; });
+
+		detail::slab_allocator<Node> allocator{};
+		if (nodes.size() > List::slab_threshold) {
+			auto slab{ detail::node_slab::create(nodes.size()) };
+			allocator = detail::slab_allocator<Node>(slab);
+			slab->release();
+		}
+
+		// Lays out each heavy path in traversal order
+		std::vector<std::shared_ptr<Node>> relocated(nodes.size());
+		std::vector<std::size_t> path{};
+		for (auto pathEnd : pathEnds) {
+			path.clear();
+			for (auto index{ pathEnd }; index != none; index = heavyPredecessors[index]) {
+				path.push_back(index);
+			}
+
+			for (auto index{ path.rbegin() }; index != path.rend(); ++index) {
+				relocated[*index] = std::allocate_shared<Node>(allocator, nodes[*index]->data, nodes[*index]->count);
+			}
+		}
+
+		for (std::size_t index{ 0 }; index < nodes.size(); ++index) {
+			if (nextIndexes[index] != none) {
+				relocated[index]->next = relocated[nextIndexes[index]];
+			}
+		}
+
+		compacted_versions<List> result{};
+		result.versions.reserve(originals.size());
+		for (std::size_t version{ 0 }; version < originals.size(); ++version) {
+			result.versions.push_back(headIndexes[version] == none ? List{} : List(typename List::node_tag{}, relocated[headIndexes[version]], originals[version].m_size));
+		}
+
+		std::size_t independentNodeCount{ 0 };
+		for (auto versionCount : traffic) {
+			independentNodeCount += versionCount;
+		}
+		result.bytes_saved = (independentNodeCount - nodes.size()) * sizeof(Node);
+
+		return result;
+	}
+
+	/*!
+	 * @brief	Compacts a list on a background thread
+	 *
+	 * The list is kept alive by the task until the compaction is done.
+	 *
+	 * @returns	A future that holds the compacted list
+	 */
+
+	template<typename T>
+	inline std::future<immutable_list<T>> compact_async(immutable_list<T> list)
+	{
+		return std::async(std::launch::async, [list = std::move(list)]() { return compact(list); });
+	}
+
+	/*!
+	 * @brief	Compacts the list published in version on a background thread, atomically swapping the compacted list in
+	 *
+	 * The compacted list replaces the published one only if version still holds the list that was compacted, so that
+	 * a newer list published while the compaction was running is never overwritten.
+	 * version must be read and written only trough the std::atomic_* functions for shared_ptr, and must outlive the returned future.
+	 *
+	 * @returns	A future that holds true if the compacted list was swapped in, false otherwise
+	 */
+
+	template<typename T>
+	inline std::future<bool> compact_async(std::shared_ptr<const immutable_list<T>>& version)
+	{
+		return std::async(std::launch::async, [&version]() {
+			auto expected{ std::atomic_load(&version) };
+			if (!expected) {
+				return false;
+			}
+
+			auto compacted{ std::make_shared<const immutable_list<T>>(compact(*expected)) };
+
+			return std::atomic_compare_exchange_strong(&version, &expected, std::move(compacted));
+		});
+	}
+
+	// SORTING
+
+	/*!
+	 * @brief	Generates a new list with the elements of list sorted by comp
+	 *
+	 * The longest sorted suffix of list is detected in a single walk. Only the elements before it are sorted, and the part of the suffix
+	 * that follows all of them is shared, so that sorting a list with a few elements prepended to a sorted list copies just the ones that move.
+	 * The copied elements are laid out in a single slab, in traversal order.
+	 * 
+	 * When policy is execution::par and the list is long enough, the elements are sorted concurrently, a chunk per hardware thread.
+	 * 
+	 * sort does not keep the order of equivalent elements, while stable_sort does.
+	 * Requires T to be copy constructible or boxed_payload<T> to hold.
+	 *
+	 * @param	policy	The execution policy
+	 * @param	list	The list to sort
+	 * @param	comp	The strict weak ordering of the elements
+	 *
+	 * @returns	A new list with the elements of list in sorted order
+	 */
+
+	template<typename ExecutionPolicy, typename T, typename Compare>
+	inline immutable_list<T> sort(ExecutionPolicy&& policy, const immutable_list<T>& list, Compare comp)
+	{
+		return list.sorted(std::forward<ExecutionPolicy>(policy), comp, false);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template<typename T, typename Compare = std::less<>>
+	inline immutable_list<T> sort(const immutable_list<T>& list, Compare comp = Compare{})
+	{
+		return sort(execution::seq, list, comp);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template<typename ExecutionPolicy, typename T,
+		     typename = std::enable_if_t<is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+	inline immutable_list<T> sort(ExecutionPolicy&& policy, const immutable_list<T>& list)
+	{
+		return sort(std::forward<ExecutionPolicy>(policy), list, std::less<>{});
+	}
+
+	/*!
+	 * @copydoc	sort
+	 */
+
+	template<typename ExecutionPolicy, typename T, typename Compare>
+	inline immutable_list<T> stable_sort(ExecutionPolicy&& policy, const immutable_list<T>& list, Compare comp)
+	{
+		return list.sorted(std::forward<ExecutionPolicy>(policy), comp, true);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template<typename T, typename Compare = std::less<>>
+	inline immutable_list<T> stable_sort(const immutable_list<T>& list, Compare comp = Compare{})
+	{
+		return stable_sort(execution::seq, list, comp);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template<typename ExecutionPolicy, typename T,
+		     typename = std::enable_if_t<is_execution_policy_v<std::decay_t<ExecutionPolicy>>>>
+	inline immutable_list<T> stable_sort(ExecutionPolicy&& policy, const immutable_list<T>& list)
+	{
+		return stable_sort(std::forward<ExecutionPolicy>(policy), list, std::less<>{});
+	}
+
+	/*!
+	 * @brief	Generates a new list with the elements of list sorted by the arithmetic key that key returns for them, with a least significant digit radix sort
+	 *
+	 * Each element is gathered, with its key, in a scratch buffer. The histograms of all the bytes of the keys are counted in a single pass,
+	 * and each byte that is not the same for all the keys is then sorted with a scatter pass between two buffers.
+	 * The sort is stable, and its cost is linear in the size of the list, so that it is much faster than sort for long lists of integer or floating point keys.
+	 * All the elements are copied in a single slab, in traversal order.
+	 * 
+	 * Negative floating point numbers are ordered before the positive ones, negative zero before zero, and NaNs at either end, depending on their sign.
+	 * Requires T to be copy constructible or boxed_payload<T> to hold.
+	 *
+	 * @param	list	The list to sort
+	 * @param	key		A function that returns the arithmetic key of an element
+	 *
+	 * @returns	A new list with the elements of list sorted by ascending key
+	 */
+
+	template<typename T, typename KeyFunction>
+	inline immutable_list<T> radix_sort(const immutable_list<T>& list, KeyFunction key)
+	{
+		using Node = typename immutable_list<T>::Node;
+		using Payload = detail::node_payload<T>;
+		using Key = decltype(detail::radix_key(std::invoke(key, std::declval<const T&>())));
+
+		static_assert(immutable_list<T>::copyable_payload, "radix_sort copies the elements of the list, which requires T to be copy constructible or boxed_payload<T> to hold");
+
+		if (list.m_size < 2) {
+			return list;
+		}
+
+		struct Entry {
+			Key key;
+			const Payload* payload;
+		};
+
+		std::vector<Entry> entries{};
+		entries.reserve(list.m_size);
+		for (const Node* node{ list.head.get() }; node; node = node->next.get()) {
+			entries.insert(entries.end(), node->count, Entry{ detail::radix_key(std::invoke(key, node->data.get())), &node->data });
+		}
+
+		constexpr std::size_t digit_count{ sizeof(Key) };
+		constexpr std::size_t radix{ 256 };
+
+		auto digit{ [](Key entryKey, std::size_t index) { return static_cast<std::size_t>((entryKey >> (index * 8)) & (radix - 1)); } };
+
+		std::vector<std::array<std::size_t, radix>> histograms(digit_count);
+		for (const auto& entry : entries) {
+			for (std::size_t index{ 0 }; index < digit_count; ++index) {
+				++histograms[index][digit(entry.key, index)];
+			}
+		}
+
+		std::vector<Entry> scattered(entries.size());
+		for (std::size_t index{ 0 }; index < digit_count; ++index) {
+			auto& histogram{ histograms[index] };
+
+			// A digit that is the same for all the keys does not reorder them
+			if (histogram[digit(entries.front().key, index)] == entries.size()) {
+				continue;
+			}
+
+			std::size_t offset{ 0 };
+			for (auto& count : histogram) {
+				offset += std::exchange(count, offset);
+			}
+
+			for (const auto& entry : entries) {
+				scattered[histogram[digit(entry.key, index)]++] = entry;
+			}
+
+			entries.swap(scattered);
+		}
+
+		detail::slab_allocator<Node> allocator{};
+		if (entries.size() > immutable_list<T>::slab_threshold) {
+			auto slab{ detail::node_slab::create(entries.size()) };
+			allocator = detail::slab_allocator<Node>(slab);
+			slab->release();
+		}
+
+		std::shared_ptr<Node> head{};
+		std::shared_ptr<Node>* link{ &head };
+		for (const auto& entry : entries) {
+			*link = std::allocate_shared<Node>(allocator, *entry.payload);
+			link = &(*link)->next;
+		}
+
+		return immutable_list<T>(typename immutable_list<T>::node_tag{}, std::move(head), list.m_size);
+	}
+
+	/*!
+	 * @overload
+	 *
+	 * Sorts a list of arithmetic elements by their value.
+	 */
+
+	template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+	inline immutable_list<T> radix_sort(const immutable_list<T>& list)
+	{
+		return radix_sort(list, [](const T& element) { return element; });
+	}
+
+	// IMMUTABLE_LIST_ITERATOR IMPLEMENTATION //
+
+	template<typename T>
+	inline bool operator==(const immutable_list_iterator<T>& left, const immutable_list_iterator<T>& right) noexcept
+	{
+		return left.node.lock() == right.node.lock() && left.offset == right.offset;
+	}
+
+	template<typename T>
+	inline bool operator!=(const immutable_list_iterator<T>& left, const immutable_list_iterator<T>& right) noexcept
+	{
+		return !(left == right);
+	}
+
+	template<typename T>
+	inline immutable_list_iterator<T>& immutable_list_iterator<T>::operator++()
+	{
+		auto current{ this->node.lock() };
+		if (++this->offset < current->count) {
+			return *this;
+		}
+
+		this->node = current->next;
+		this->offset = 0;
+
+		return *this;
 	}
 
 	template<typename T>
@@ -775,12 +3177,140 @@ namespace lds {
 	template<typename T>
 	typename inline immutable_list_iterator<T>::reference immutable_list_iterator<T>::operator*() const
 	{
-		return this->node.lock()->data;
+		return this->node.lock()->data.get();
 	}
 
 	template<typename T>
 	typename inline immutable_list_iterator<T>::pointer immutable_list_iterator<T>::operator->() const
 	{
-		return &(this->node.lock()->data);
+		return &(this->node.lock()->data.get());
 	}
+
+	// FROZEN_LIST //
+
+	/*!
+	 * @class	frozen_list
+	 *
+	 * @brief	An immutable snapshot of an immutable_list, with its elements stored in a contiguous array
+	 *
+	 * A frozen_list provides constant time indexing and random access iterators, and its elements can be viewed as a contiguous range trough data() and size().
+	 * Copying a frozen_list is cheap, as copies share the same array.
+	 * 
+	 * frozen_lists are generated by immutable_list::freeze and converted back by thaw.
+	 *
+	 * @tparam	T	Generic type parameter.
+	 */
+
+	template <typename T>
+	class frozen_list {
+		friend class immutable_list<T>;
+
+	public:
+		using value_type = T;
+		using reference = const value_type&;
+		using const_reference = const value_type&;
+		using const_iterator = const value_type*;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+	public:
+		frozen_list() noexcept : elements{} {}
+
+	public:
+
+		/*!
+		 * @name Element Access
+		 */
+		///@{
+
+		[[nodiscard]] const_reference front() const {
+			return (*this)[0];
+		}
+
+		const_reference at(size_type index) const {
+			if (index >= this->size()) {
+				throw std::out_of_range((std::stringstream() << "The list does not contain index " << index).str());
+			}
+
+			return (*this)[index];
+		}
+
+		const_reference operator[](size_type index) const {
+			return this->data()[index];
+		}
+
+		[[nodiscard]] const value_type* data() const noexcept {
+			return this->elements ? this->elements->data() : nullptr;
+		}
+
+		///@}
+
+	public:
+
+		/*! @name Iterators
+		 */
+		 ///@{
+
+		[[nodiscard]] const_iterator cbegin() const noexcept {
+			return this->data();
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept {
+			return this->data() + this->size();
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept {
+			return this->cbegin();
+		}
+
+		[[nodiscard]] const_iterator end() const noexcept {
+			return this->cend();
+		}
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Capacity
+		 */
+		 ///@{
+
+		[[nodiscard]] bool empty() const noexcept {
+			return !this->size();
+		}
+
+		[[nodiscard]] size_type size() const noexcept {
+			return this->elements ? this->elements->size() : 0;
+		}
+
+		///@}
+
+	public:
+
+		/*!
+		 * @brief	Converts the snapshot back into an immutable_list
+		 *
+		 * The nodes of the new list are allocated in a single contiguous slab.
+		 */
+
+		[[nodiscard]] immutable_list<T> thaw() const {
+			return immutable_list<T>(this->cbegin(), this->cend());
+		}
+
+	public: // OPERATORS
+		friend bool operator==(const frozen_list<T>& left, const frozen_list<T>& right) {
+			return std::equal(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+		}
+
+		friend bool operator!=(const frozen_list<T>& left, const frozen_list<T>& right) {
+			return !(left == right);
+		}
+
+	private:
+		explicit frozen_list(std::shared_ptr<const std::vector<T>> elements) noexcept : elements{ std::move(elements) } {}
+
+	private:
+		std::shared_ptr<const std::vector<T>> elements;
+	};
 }
\ No newline at end of file
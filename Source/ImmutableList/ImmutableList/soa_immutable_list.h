@@ -0,0 +1,526 @@
+// Copyright 2018 Luca Di Sera
+//		Contact: disera.luca@gmail.com
+//				 https://github.com/diseraluca
+//				 https://www.linkedin.com/in/luca-di-sera-200023167
+//
+// This code is licensed under the MIT License.
+// More informations can be found in the LICENSE file in the root folder of this repository
+
+/*! \file */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lds {
+	template <typename... Fields>
+	class soa_immutable_list;
+
+	/*!
+	 * @class	column_span
+	 *
+	 * @brief	A contiguous, read-only view over the values of one field
+	 *
+	 * @tparam	Field	The type of the field.
+	 */
+
+	template <typename Field>
+	class column_span {
+	public:
+		using value_type = Field;
+		using const_iterator = const Field*;
+		using size_type = std::size_t;
+
+	public:
+		constexpr column_span() noexcept : m_data{ nullptr }, m_size{ 0 } {}
+		constexpr column_span(const Field* data, size_type size) noexcept : m_data{ data }, m_size{ size } {}
+
+		[[nodiscard]] constexpr const Field* data() const noexcept { return this->m_data; }
+		[[nodiscard]] constexpr size_type size() const noexcept { return this->m_size; }
+		[[nodiscard]] constexpr bool empty() const noexcept { return !this->m_size; }
+
+		[[nodiscard]] constexpr const Field& operator[](size_type index) const noexcept { return this->m_data[index]; }
+
+		[[nodiscard]] constexpr const_iterator begin() const noexcept { return this->m_data; }
+		[[nodiscard]] constexpr const_iterator end() const noexcept { return this->m_data + this->m_size; }
+
+	private:
+		const Field* m_data;
+		size_type m_size;
+	};
+
+	namespace detail {
+
+		/*!
+		 * @struct	soa_chunk
+		 *
+		 * @brief	A node of a soa_immutable_list, storing chunk_size elements with each field in its own array
+		 */
+
+		template <typename... Fields>
+		struct soa_chunk {
+			static constexpr std::size_t chunk_size{ 64 };
+
+			template <std::size_t... Indexes>
+			void store(std::size_t position, const std::tuple<Fields...>& value, std::index_sequence<Indexes...>) const {
+				((std::get<Indexes>(this->columns)[position] = std::get<Indexes>(value)), ...);
+			}
+
+			/*!
+			 * @brief	Copies the slots of other in the range [first, chunk_size), and its successor
+			 *
+			 * The slots before first are not read, as another list may be writing them.
+			 */
+
+			template <std::size_t... Indexes>
+			void copy_from(const soa_chunk& other, std::size_t first, std::index_sequence<Indexes...>) {
+				(std::copy(std::get<Indexes>(other.columns).cbegin() + first, std::get<Indexes>(other.columns).cend(), std::get<Indexes>(this->columns).begin() + first), ...);
+				this->next = other.next;
+			}
+
+			/*!
+			 * @brief	Stores value in the free slot just before the slot already claimed, if position is that free slot
+			 *
+			 * Returns false when another list has already claimed position, in which case the chunk is left untouched.
+			 */
+
+			template <std::size_t... Indexes>
+			bool claim(std::size_t position, const std::tuple<Fields...>& value, std::index_sequence<Indexes...> indexes) const {
+				auto expected{ position + 1 };
+				if (!this->claimed.compare_exchange_strong(expected, position)) {
+					return false;
+				}
+
+				this->store(position, value, indexes);
+
+				return true;
+			}
+
+			template <std::size_t... Indexes>
+			[[nodiscard]] std::tuple<const Fields&...> load(std::size_t position, std::index_sequence<Indexes...>) const noexcept {
+				return std::tuple<const Fields&...>{ std::get<Indexes>(this->columns)[position]... };
+			}
+
+			// Slots are only ever written before the lowest slot claimed by a list, so that shared slots are never modified
+			mutable std::tuple<std::array<Fields, chunk_size>...> columns{};
+			mutable std::atomic<std::size_t> claimed{ 0 };
+			std::shared_ptr<const soa_chunk> next{};
+		};
+	}
+
+	/*!
+	 * @class	soa_immutable_list_iterator
+	 *
+	 * @brief	A structure-of-arrays immutable list iterator.
+	 *
+	 * Dereferencing the iterator returns a tuple of references to the fields of the element.
+	 * An iterator is valid as long as a list that contains the element it points to is alive.
+	 */
+
+	template <typename... Fields>
+	class soa_immutable_list_iterator {
+		friend class soa_immutable_list<Fields...>;
+
+	public:
+		using value_type = std::tuple<Fields...>;
+		using reference = std::tuple<const Fields&...>;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+	public:
+		soa_immutable_list_iterator() =default;
+
+	public:
+		friend bool operator==(const soa_immutable_list_iterator& left, const soa_immutable_list_iterator& right) noexcept {
+			return left.chunk == right.chunk && left.index == right.index;
+		}
+
+		friend bool operator!=(const soa_immutable_list_iterator& left, const soa_immutable_list_iterator& right) noexcept {
+			return !(left == right);
+		}
+
+		soa_immutable_list_iterator& operator++() noexcept;
+		soa_immutable_list_iterator operator++(int) noexcept;
+
+		[[nodiscard]] reference operator*() const noexcept;
+
+	private:
+		using Chunk = detail::soa_chunk<Fields...>;
+
+		soa_immutable_list_iterator(const Chunk* chunk, std::size_t index) noexcept : chunk{ chunk }, index{ index } {}
+
+	private:
+		const Chunk* chunk{ nullptr };
+		std::size_t index{ 0 };
+	};
+
+	/*!
+	 * @class	soa_immutable_list
+	 *
+	 * @brief	An immutable singly-linked list of aggregates, stored as a structure of arrays
+	 *
+	 * Elements are tuples of Fields. Each node stores a chunk of elements, with the values of each field in their own contiguous array,
+	 * so that a scan that reads only some of the fields brings only those fields into cache and can be vectorized.
+	 *
+	 * The first chunk of a list may be partially used, while all the chunks that follow it are full, so that chunks can be shared between lists.
+	 * push_front writes in the free slot before the first element of the first chunk, which it shares with this list,
+	 * so that a chain of push_front calls allocates a new chunk only once every chunk_size elements.
+	 * Only the first list to push in front of a given list can take the free slot: the others work on a copy of the first chunk.
+	 * pop_front never allocates.
+	 *
+	 * Each field must be default constructible and copy assignable.
+	 *
+	 * @tparam	Fields	The types of the fields of an element.
+	 */
+
+	template <typename... Fields>
+	class soa_immutable_list {
+		static_assert(sizeof...(Fields) > 0, "soa_immutable_list requires at least one field");
+
+		friend class soa_immutable_list_iterator<Fields...>;
+
+	public:
+		using value_type = std::tuple<Fields...>;
+		using reference = std::tuple<const Fields&...>;
+		using const_reference = std::tuple<const Fields&...>;
+		using const_iterator = soa_immutable_list_iterator<Fields...>;
+		using size_type = std::size_t;
+
+		template <std::size_t Index>
+		using field_type = std::tuple_element_t<Index, value_type>;
+
+		static constexpr size_type chunk_size{ detail::soa_chunk<Fields...>::chunk_size };
+
+	public:
+
+		/*! @name Constructors
+	     */
+	     ///@{
+
+		soa_immutable_list() noexcept : head{}, offset{ 0 }, m_size{ 0 } {}
+
+		template <typename InputIterator,
+			      typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+		soa_immutable_list(InputIterator first, InputIterator last);
+
+		explicit soa_immutable_list(std::initializer_list<value_type> list) : soa_immutable_list(list.begin(), list.end()) {}
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Element Access
+		 */
+		///@{
+
+		[[nodiscard]] const_reference front() const;
+
+		const_reference at(size_type index) const;
+		const_reference operator[](size_type index) const;
+
+		///@}
+
+	public:
+
+		/*! @name Iterators
+		 */
+		 ///@{
+
+		[[nodiscard]] const_iterator cbegin() const noexcept {
+			return const_iterator{ this->head.get(), this->offset };
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept {
+			return const_iterator{};
+		}
+
+		template <std::size_t Index, typename SpanVisitor>
+		void for_each_span(SpanVisitor visitor) const;
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Modifiers
+		 *
+		 * Each modifier return a new list that models the result of a modification.
+		 * The original list isn't modified in any way.
+		 *
+		 * Modifiers ensures a Strong Exception Garuantee
+		 */
+		///@{
+
+		[[nodiscard]] soa_immutable_list clear() const noexcept;
+
+		[[nodiscard]] soa_immutable_list push_front(const value_type& data) const;
+		[[nodiscard]] soa_immutable_list push_front(const Fields&... fields) const;
+
+		[[nodiscard]] soa_immutable_list pop_front() const noexcept;
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Capacity
+		 */
+		 ///@{
+
+		[[nodiscard]] bool empty() const noexcept;
+
+		[[nodiscard]] size_type size() const noexcept;
+
+		[[nodiscard]] constexpr size_type max_size() const noexcept;
+
+		///@}
+
+	public: // OPERATORS
+		friend bool operator==(const soa_immutable_list& left, const soa_immutable_list& right) {
+			return left.m_size == right.m_size && std::equal(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+		}
+
+		friend bool operator!=(const soa_immutable_list& left, const soa_immutable_list& right) {
+			return !(left == right);
+		}
+
+	private:
+		using Chunk = detail::soa_chunk<Fields...>;
+		using field_indexes = std::index_sequence_for<Fields...>;
+
+		soa_immutable_list(std::shared_ptr<const Chunk> head, size_type offset, size_type size) noexcept : head{ std::move(head) }, offset{ offset }, m_size{ size } {}
+
+	private:
+		std::shared_ptr<const Chunk> head;
+
+		// The position, in the first chunk, of the first element of the list
+		size_type offset;
+		size_type m_size;
+	};
+
+	/*!
+	 * @brief	Constructs a new list from the content of the range [first, last)
+	 *
+	 * The elements of the range must be convertible to value_type.
+	 * The chunks are filled from the back, so that only the first one may be partially used.
+	 */
+
+	template <typename... Fields>
+	template <typename InputIterator, typename>
+	inline soa_immutable_list<Fields...>::soa_immutable_list(InputIterator first, InputIterator last) : soa_immutable_list()
+	{
+		std::vector<value_type> elements(first, last);
+		if (elements.empty()) {
+			return;
+		}
+
+		auto chunkCount{ (elements.size() + chunk_size - 1) / chunk_size };
+		this->offset = chunkCount * chunk_size - elements.size();
+		this->m_size = elements.size();
+
+		std::shared_ptr<Chunk> newHead{ std::make_shared<Chunk>() };
+		Chunk* current{ newHead.get() };
+		auto position{ this->offset };
+		for (const auto& element : elements) {
+			if (position == chunk_size) {
+				auto nextChunk{ std::make_shared<Chunk>() };
+				current->next = nextChunk;
+				current = nextChunk.get();
+				position = 0;
+			}
+
+			current->store(position++, element, field_indexes{});
+		}
+		newHead->claimed.store(this->offset, std::memory_order_relaxed);
+
+		this->head = std::move(newHead);
+	}
+
+	/*!
+	 * @brief	Gets the fields of the first element of the container
+	 *
+	 * Calling front on an empty list is considered undefined behaviour.
+	 */
+
+	template <typename... Fields>
+	typename inline soa_immutable_list<Fields...>::const_reference soa_immutable_list<Fields...>::front() const
+	{
+		return this->head->load(this->offset, field_indexes{});
+	}
+
+	/*!
+	 * @brief	Gets the fields of the ith element of the list. at is range checked.
+	 *
+	 * @exception	std::out_of_range	Thrown when index >= size().
+	 */
+
+	template <typename... Fields>
+	typename inline soa_immutable_list<Fields...>::const_reference soa_immutable_list<Fields...>::at(size_type index) const
+	{
+		if (index >= this->m_size) {
+			throw std::out_of_range((std::stringstream() << "The list does not contain index " << index).str());
+		}
+
+		return (*this)[index];
+	}
+
+	/*!
+	 * @brief	Gets the fields of the ith element of the list.
+	 *
+	 * Whole chunks are skipped, so that the cost is proportional to index / chunk_size.
+	 */
+
+	template <typename... Fields>
+	typename inline soa_immutable_list<Fields...>::const_reference soa_immutable_list<Fields...>::operator[](size_type index) const
+	{
+		index += this->offset;
+
+		const Chunk* chunk{ this->head.get() };
+		for (; index >= chunk_size; index -= chunk_size) {
+			chunk = chunk->next.get();
+		}
+
+		return chunk->load(index, field_indexes{});
+	}
+
+	/*!
+	 * @brief	Calls visitor with a column_span over the values of the field Index, for each chunk of the list, in order
+	 *
+	 * Together, the spans cover the values of the field for all the elements of the list.
+	 *
+	 * @tparam	Index	The index of the field to visit.
+	 * @param	visitor	A callable that accepts a column_span<field_type<Index>>.
+	 */
+
+	template <typename... Fields>
+	template <std::size_t Index, typename SpanVisitor>
+	inline void soa_immutable_list<Fields...>::for_each_span(SpanVisitor visitor) const
+	{
+		auto start{ this->offset };
+		for (const Chunk* chunk{ this->head.get() }; chunk; chunk = chunk->next.get(), start = 0) {
+			visitor(column_span<field_type<Index>>{ std::get<Index>(chunk->columns).data() + start, chunk_size - start });
+		}
+	}
+
+	template <typename... Fields>
+	inline soa_immutable_list<Fields...> soa_immutable_list<Fields...>::clear() const noexcept
+	{
+		return soa_immutable_list<Fields...>();
+	}
+
+	/*!
+	 * @brief	Generates a new list with an element prepended to it
+	 *
+	 * When this list is the first to push in front of its first element, the element takes the free slot before it and the new list
+	 * shares the first chunk of this list, without allocating.
+	 * Otherwise the used slots of the first chunk are copied, or, when it is full, a new chunk is allocated.
+	 */
+
+	template <typename... Fields>
+	inline soa_immutable_list<Fields...> soa_immutable_list<Fields...>::push_front(const value_type& data) const
+	{
+		if (this->head && this->offset > 0) {
+			if (this->head->claim(this->offset - 1, data, field_indexes{})) {
+				return soa_immutable_list<Fields...>(this->head, this->offset - 1, this->m_size + 1);
+			}
+
+			auto chunk{ std::make_shared<Chunk>() };
+			chunk->copy_from(*this->head, this->offset, field_indexes{});
+			chunk->store(this->offset - 1, data, field_indexes{});
+			chunk->claimed.store(this->offset - 1, std::memory_order_relaxed);
+
+			return soa_immutable_list<Fields...>(std::move(chunk), this->offset - 1, this->m_size + 1);
+		}
+
+		auto chunk{ std::make_shared<Chunk>() };
+		chunk->store(chunk_size - 1, data, field_indexes{});
+		chunk->claimed.store(chunk_size - 1, std::memory_order_relaxed);
+		chunk->next = this->head;
+
+		return soa_immutable_list<Fields...>(std::move(chunk), chunk_size - 1, this->m_size + 1);
+	}
+
+	/*!
+	 * @overload
+	 */
+
+	template <typename... Fields>
+	inline soa_immutable_list<Fields...> soa_immutable_list<Fields...>::push_front(const Fields&... fields) const
+	{
+		return this->push_front(value_type{ fields... });
+	}
+
+	/*!
+	 * @brief	Generates a new list with an the front element removed
+	 *
+	 * Never allocates, as the new list shares all the chunks of this list.
+	 */
+
+	template <typename... Fields>
+	inline soa_immutable_list<Fields...> soa_immutable_list<Fields...>::pop_front() const noexcept
+	{
+		if (this->offset + 1 == chunk_size) {
+			return soa_immutable_list<Fields...>(this->head->next, 0, this->m_size - 1);
+		}
+
+		return soa_immutable_list<Fields...>(this->head, this->offset + 1, this->m_size - 1);
+	}
+
+	template <typename... Fields>
+	inline bool soa_immutable_list<Fields...>::empty() const noexcept
+	{
+		return !this->m_size;
+	}
+
+	template <typename... Fields>
+	typename inline soa_immutable_list<Fields...>::size_type soa_immutable_list<Fields...>::size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	template <typename... Fields>
+	typename inline constexpr soa_immutable_list<Fields...>::size_type soa_immutable_list<Fields...>::max_size() const noexcept
+	{
+		return std::numeric_limits<size_type>::max();
+	}
+
+	// SOA_IMMUTABLE_LIST_ITERATOR IMPLEMENTATION //
+
+	template <typename... Fields>
+	inline soa_immutable_list_iterator<Fields...>& soa_immutable_list_iterator<Fields...>::operator++() noexcept
+	{
+		if (++this->index == Chunk::chunk_size) {
+			this->chunk = this->chunk->next.get();
+			this->index = 0;
+		}
+
+		return *this;
+	}
+
+	template <typename... Fields>
+	inline soa_immutable_list_iterator<Fields...> soa_immutable_list_iterator<Fields...>::operator++(int) noexcept
+	{
+		soa_immutable_list_iterator<Fields...> previous{ *this };
+		++(*this);
+
+		return previous;
+	}
+
+	template <typename... Fields>
+	typename inline soa_immutable_list_iterator<Fields...>::reference soa_immutable_list_iterator<Fields...>::operator*() const noexcept
+	{
+		return this->chunk->load(this->index, std::index_sequence_for<Fields...>{});
+	}
+}
@@ -0,0 +1,802 @@
+// Copyright 2018 Luca Di Sera
+//		Contact: disera.luca@gmail.com
+//				 https://github.com/diseraluca
+//				 https://www.linkedin.com/in/luca-di-sera-200023167
+//
+// This code is licensed under the MIT License.
+// More informations can be found in the LICENSE file in the root folder of this repository
+
+/*! \file */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lds {
+	template <typename T>
+	class spilling_immutable_list;
+
+	template <typename T>
+	class spilling_immutable_list_iterator;
+
+	namespace detail {
+		template <typename T>
+		struct spilled_segment;
+	}
+
+	/*!
+	 * @class	segment_store
+	 *
+	 * @brief	A file-backed store of fixed-size, immutable segments of elements, that keeps at most a given number of bytes of them in memory
+	 *
+	 * When the resident segments exceed the memory budget, the least recently used ones that are not in use are evicted.
+	 * A segment is written to the backing file the first time it is evicted, and read back from it whenever it is needed again.
+	 * As segments never change, a segment that is evicted again is not written a second time.
+	 * The file slots of removed segments are reused by later segments.
+	 *
+	 * The budget is a soft limit, as segments that are in use by an iterator or an access can't be evicted.
+	 *
+	 * All the operations on a store are thread-safe.
+	 *
+	 * @tparam	T	The element type. Must be trivially copyable, as it is stored in the file by its bytes.
+	 */
+
+	template <typename T>
+	class segment_store {
+		static_assert(std::is_trivially_copyable_v<T>, "segment_store requires a trivially copyable element type");
+
+		friend class spilling_immutable_list<T>;
+		friend class spilling_immutable_list_iterator<T>;
+		friend struct detail::spilled_segment<T>;
+
+	public:
+		using size_type = std::size_t;
+		using segment_id = std::size_t;
+		using segment = std::vector<T>;
+
+		static constexpr size_type default_segment_size{ 1024 };
+
+	public:
+
+		/*!
+		 * @brief	Creates a new store, backed by the file at path
+		 *
+		 * The file is created, or truncated if it exists.
+		 *
+		 * @param	path			The path of the backing file
+		 * @param	memoryBudget	The number of bytes of segments that may be kept in memory
+		 * @param	segmentSize		The number of elements of each segment
+		 *
+		 * @exception	std::ios_base::failure	Thrown when the backing file can't be opened.
+		 */
+
+		[[nodiscard]] static std::shared_ptr<segment_store<T>> create(const std::string& path, size_type memoryBudget, size_type segmentSize = default_segment_size) {
+			return std::shared_ptr<segment_store<T>>(new segment_store<T>(path, memoryBudget, segmentSize));
+		}
+
+		segment_store(const segment_store& other) =delete;
+		segment_store& operator=(const segment_store& other) =delete;
+
+		[[nodiscard]] size_type segment_size() const noexcept {
+			return this->segmentSize;
+		}
+
+		[[nodiscard]] size_type memory_budget() const noexcept {
+			return this->memoryBudget;
+		}
+
+		[[nodiscard]] size_type resident_bytes() const {
+			std::lock_guard<std::mutex> lock{ this->mutex };
+			return this->residentBytes;
+		}
+
+	private:
+		struct Entry {
+			std::shared_ptr<segment> data{};
+			std::list<segment_id>::iterator recency{};
+
+			// The slot of the backing file that holds the segment, if it was ever evicted
+			size_type slot{ no_slot };
+		};
+
+		static constexpr size_type no_slot{ std::numeric_limits<size_type>::max() };
+
+		segment_store(const std::string& path, size_type memoryBudget, size_type segmentSize);
+
+		[[nodiscard]] segment_id add(segment&& data);
+		[[nodiscard]] std::shared_ptr<const segment> load(segment_id id);
+		void write(segment_id id, size_type position, const T& value);
+		void remove(segment_id id) noexcept;
+
+		void make_resident(Entry& entry, segment_id id, std::shared_ptr<segment> data);
+		void evict_over_budget();
+
+		[[nodiscard]] size_type segment_bytes() const noexcept {
+			return this->segmentSize * sizeof(T);
+		}
+
+	private:
+		mutable std::mutex mutex;
+		std::fstream file;
+
+		size_type memoryBudget;
+		size_type segmentSize;
+		size_type residentBytes;
+
+		std::vector<Entry> entries;
+		std::vector<segment_id> freeIds;
+		std::vector<size_type> freeSlots;
+		size_type slotCount;
+
+		// Resident segments, from the most to the least recently used
+		std::list<segment_id> recency;
+	};
+
+	template <typename T>
+	inline segment_store<T>::segment_store(const std::string& path, size_type memoryBudget, size_type segmentSize)
+		: mutex{}, file{}, memoryBudget{ memoryBudget }, segmentSize{ segmentSize }, residentBytes{ 0 }, entries{}, freeIds{}, freeSlots{}, slotCount{ 0 }, recency{}
+	{
+		this->file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+		this->file.open(path, std::ios_base::in | std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	}
+
+	/*!
+	 * @brief	Adds a resident segment to the store, evicting older segments if the budget is exceeded
+	 *
+	 * The segment is registered only once the evictions have succeeded, so that a failed write leaves the store as it was.
+	 *
+	 * @exception	std::ios_base::failure	Thrown when an evicted segment can't be written.
+	 */
+
+	template <typename T>
+	typename inline segment_store<T>::segment_id segment_store<T>::add(segment&& data)
+	{
+		auto resident{ std::make_shared<segment>(std::move(data)) };
+
+		std::lock_guard<std::mutex> lock{ this->mutex };
+
+		auto reused{ !this->freeIds.empty() };
+		segment_id id{ reused ? this->freeIds.back() : this->entries.size() };
+		if (!reused) {
+			this->entries.emplace_back();
+		}
+
+		auto& entry{ this->entries[id] };
+		try {
+			this->make_resident(entry, id, std::move(resident));
+			this->evict_over_budget();
+		} catch (...) {
+			if (entry.data) {
+				this->recency.erase(entry.recency);
+				this->residentBytes -= this->segment_bytes();
+			}
+
+			entry = Entry{};
+			if (!reused) {
+				this->entries.pop_back();
+			}
+
+			throw;
+		}
+
+		if (reused) {
+			this->freeIds.pop_back();
+		}
+
+		return id;
+	}
+
+	/*!
+	 * @brief	Gets a segment, reading it back from the backing file if it was evicted
+	 *
+	 * The segment can't be evicted as long as the returned pointer, or a copy of it, is alive.
+	 *
+	 * @exception	std::ios_base::failure	Thrown when the segment can't be read.
+	 */
+
+	template <typename T>
+	inline std::shared_ptr<const typename segment_store<T>::segment> segment_store<T>::load(segment_id id)
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex };
+
+		auto& entry{ this->entries[id] };
+		if (entry.data) {
+			this->recency.splice(this->recency.begin(), this->recency, entry.recency);
+			return entry.data;
+		}
+
+		auto data{ std::make_shared<segment>(this->segmentSize) };
+		this->file.seekg(static_cast<std::streamoff>(entry.slot * this->segment_bytes()));
+		this->file.read(reinterpret_cast<char*>(data->data()), static_cast<std::streamsize>(this->segment_bytes()));
+
+		this->make_resident(entry, id, data);
+		this->evict_over_budget();
+
+		return data;
+	}
+
+	/*!
+	 * @brief	Writes value at position, in a segment, where no list has an element yet
+	 *
+	 * A resident segment is updated in memory and forgets its copy in the backing file, if any, so that it is written again when evicted.
+	 * An evicted segment is updated in the backing file, without being loaded.
+	 *
+	 * @exception	std::ios_base::failure	Thrown when the backing file can't be written.
+	 */
+
+	template <typename T>
+	inline void segment_store<T>::write(segment_id id, size_type position, const T& value)
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex };
+
+		auto& entry{ this->entries[id] };
+		if (entry.data) {
+			if (entry.slot != no_slot) {
+				this->freeSlots.push_back(entry.slot);
+				entry.slot = no_slot;
+			}
+
+			(*entry.data)[position] = value;
+			this->recency.splice(this->recency.begin(), this->recency, entry.recency);
+
+			return;
+		}
+
+		this->file.seekp(static_cast<std::streamoff>(entry.slot * this->segment_bytes() + position * sizeof(T)));
+		this->file.write(reinterpret_cast<const char*>(&value), static_cast<std::streamsize>(sizeof(T)));
+	}
+
+	/*!
+	 * @brief	Removes a segment from the store, releasing its memory and its file slot
+	 */
+
+	template <typename T>
+	inline void segment_store<T>::remove(segment_id id) noexcept
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex };
+
+		auto& entry{ this->entries[id] };
+		if (entry.data) {
+			this->recency.erase(entry.recency);
+			this->residentBytes -= this->segment_bytes();
+		}
+
+		if (entry.slot != no_slot) {
+			this->freeSlots.push_back(entry.slot);
+		}
+
+		entry = Entry{};
+		this->freeIds.push_back(id);
+	}
+
+	template <typename T>
+	inline void segment_store<T>::make_resident(Entry& entry, segment_id id, std::shared_ptr<segment> data)
+	{
+		entry.recency = this->recency.insert(this->recency.begin(), id);
+		entry.data = std::move(data);
+		this->residentBytes += this->segment_bytes();
+	}
+
+	/*!
+	 * @brief	Evicts the least recently used segments that are not in use until the resident segments fit the budget
+	 *
+	 * A segment takes its file slot only once it has been written, so that a failed write leaves it resident and without a slot.
+	 */
+
+	template <typename T>
+	inline void segment_store<T>::evict_over_budget()
+	{
+		auto candidate{ this->recency.end() };
+		while (this->residentBytes > this->memoryBudget && candidate != this->recency.begin()) {
+			--candidate;
+
+			auto& entry{ this->entries[*candidate] };
+			if (entry.data.use_count() > 1) {
+				continue;
+			}
+
+			if (entry.slot == no_slot) {
+				auto slot{ this->freeSlots.empty() ? this->slotCount : this->freeSlots.back() };
+
+				this->file.seekp(static_cast<std::streamoff>(slot * this->segment_bytes()));
+				this->file.write(reinterpret_cast<const char*>(entry.data->data()), static_cast<std::streamsize>(this->segment_bytes()));
+
+				if (this->freeSlots.empty()) {
+					++this->slotCount;
+				} else {
+					this->freeSlots.pop_back();
+				}
+				entry.slot = slot;
+			}
+
+			entry.data.reset();
+			this->residentBytes -= this->segment_bytes();
+			candidate = this->recency.erase(candidate);
+		}
+	}
+
+	namespace detail {
+
+		/*!
+		 * @struct	spilled_segment
+		 *
+		 * @brief	A node of a spilling_immutable_list, referencing a segment of a segment_store
+		 *
+		 * Nodes are always kept in memory, while the segments they reference may be evicted.
+		 */
+
+		template <typename T>
+		struct spilled_segment {
+			spilled_segment(std::shared_ptr<segment_store<T>> store, typename segment_store<T>::segment_id id, std::size_t claimed) noexcept
+				: store{ std::move(store) }, id{ id }, claimed{ claimed }, next{} {}
+
+			spilled_segment(const spilled_segment& other) =delete;
+			spilled_segment& operator=(const spilled_segment& other) =delete;
+
+			/*!
+			 * @brief	Claims position, the free slot just before the slot already claimed, for the list that pushes in front of it
+			 *
+			 * Returns false when another list has already claimed position.
+			 */
+
+			bool claim(std::size_t position) const noexcept {
+				auto expected{ position + 1 };
+				return this->claimed.compare_exchange_strong(expected, position);
+			}
+
+			// Unlinks the uniquely owned nodes that follow this one iteratively, so that dropping a long list does not recurse once per node
+			~spilled_segment() {
+				this->store->remove(this->id);
+
+				auto following{ std::move(this->next) };
+				while (following && following.use_count() == 1) {
+					following = std::move(following->next);
+				}
+			}
+
+			std::shared_ptr<segment_store<T>> store;
+			typename segment_store<T>::segment_id id;
+
+			// The lowest position of the segment that holds an element of a list. Positions are only ever written before it
+			mutable std::atomic<std::size_t> claimed;
+			std::shared_ptr<spilled_segment> next;
+		};
+	}
+
+	/*!
+	 * @class	spilling_immutable_list_iterator
+	 *
+	 * @brief	An iterator over a spilling immutable list.
+	 *
+	 * Elements are returned by value.
+	 * The segment of the pointed to element is loaded when the iterator is first dereferenced and is kept resident until the iterator moves to the next segment.
+	 * An iterator is valid as long as a list that contains the element it points to is alive.
+	 */
+
+	template <typename T>
+	class spilling_immutable_list_iterator {
+		friend class spilling_immutable_list<T>;
+
+	public:
+		using value_type = T;
+		using reference = value_type;
+		using pointer = void;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+	public:
+		spilling_immutable_list_iterator() =default;
+
+	public:
+		friend bool operator==(const spilling_immutable_list_iterator<T>& left, const spilling_immutable_list_iterator<T>& right) noexcept {
+			return left.node == right.node && left.index == right.index;
+		}
+
+		friend bool operator!=(const spilling_immutable_list_iterator<T>& left, const spilling_immutable_list_iterator<T>& right) noexcept {
+			return !(left == right);
+		}
+
+		spilling_immutable_list_iterator<T>& operator++() noexcept;
+		spilling_immutable_list_iterator<T> operator++(int) noexcept;
+
+		[[nodiscard]] reference operator*() const;
+
+	private:
+		using Node = detail::spilled_segment<T>;
+
+		spilling_immutable_list_iterator(const Node* node, std::size_t index) noexcept : node{ node }, index{ index }, segment{} {}
+
+	private:
+		const Node* node{ nullptr };
+		std::size_t index{ 0 };
+
+		mutable std::shared_ptr<const typename segment_store<T>::segment> segment{};
+	};
+
+	/*!
+	 * @class	spilling_immutable_list
+	 *
+	 * @brief	An immutable singly-linked list whose elements are kept in the segments of a segment_store, so that cold segments are spilled to disk
+	 *
+	 * Elements are grouped in segments of segment_store::segment_size() elements. The first segment of a list may be partially used,
+	 * while all the segments that follow it are full, so that segments can be shared between lists.
+	 * Only the nodes that reference the segments, a few tens of bytes each, are always in memory.
+	 *
+	 * push_front writes in the free slot before the first element of the first segment, which it shares with this list,
+	 * so that a chain of push_front calls adds a new segment to the store only once every segment_size() elements.
+	 * Only the first list to push in front of a given list can take the free slot: the others copy the used part of the first segment.
+	 * pop_front never touches a segment.
+	 *
+	 * Accessing the ith element, trough operator[], at or by advancing an iterator, costs index / segment_size() node hops, which never touch the disk,
+	 * plus the load of the segment that holds the element, which reads segment_size() * sizeof(T) bytes from the backing file if the segment was evicted.
+	 * A full traversal reads each evicted segment once.
+	 *
+	 * @tparam	T	The element type. Must be trivially copyable.
+	 */
+
+	template <typename T>
+	class spilling_immutable_list {
+		friend class spilling_immutable_list_iterator<T>;
+
+	public:
+		using value_type = T;
+		using reference = value_type;
+		using const_reference = value_type;
+		using const_iterator = spilling_immutable_list_iterator<T>;
+		using size_type = std::size_t;
+		using store_type = segment_store<T>;
+
+	public:
+
+		/*! @name Constructors
+	     */
+	     ///@{
+
+		explicit spilling_immutable_list(std::shared_ptr<store_type> store) noexcept : store{ std::move(store) }, head{}, offset{ 0 }, m_size{ 0 } {}
+
+		template <typename InputIterator,
+			      typename = std::enable_if_t<std::is_base_of_v<std::input_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>>>
+		spilling_immutable_list(std::shared_ptr<store_type> store, InputIterator first, InputIterator last);
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Element Access
+		 */
+		///@{
+
+		[[nodiscard]] const_reference front() const;
+
+		const_reference at(size_type index) const;
+		const_reference operator[](size_type index) const;
+
+		///@}
+
+	public:
+
+		/*! @name Iterators
+		 */
+		 ///@{
+
+		[[nodiscard]] const_iterator cbegin() const noexcept {
+			return const_iterator{ this->head.get(), this->offset };
+		}
+
+		[[nodiscard]] const_iterator cend() const noexcept {
+			return const_iterator{};
+		}
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Modifiers
+		 *
+		 * Each modifier return a new list, backed by the same store, that models the result of a modification.
+		 * The original list isn't modified in any way.
+		 *
+		 * Modifiers ensures a Strong Exception Garuantee
+		 */
+		///@{
+
+		[[nodiscard]] spilling_immutable_list<T> clear() const noexcept;
+
+		[[nodiscard]] spilling_immutable_list<T> push_front(const value_type& data) const;
+
+		[[nodiscard]] spilling_immutable_list<T> pop_front() const noexcept;
+
+		///@}
+
+	public:
+
+		/*!
+		 * @name Capacity
+		 */
+		 ///@{
+
+		[[nodiscard]] bool empty() const noexcept;
+
+		[[nodiscard]] size_type size() const noexcept;
+
+		[[nodiscard]] constexpr size_type max_size() const noexcept;
+
+		[[nodiscard]] const std::shared_ptr<store_type>& backing_store() const noexcept;
+
+		///@}
+
+	public: // OPERATORS
+		friend bool operator==(const spilling_immutable_list<T>& left, const spilling_immutable_list<T>& right) {
+			return left.m_size == right.m_size && std::equal(left.cbegin(), left.cend(), right.cbegin(), right.cend());
+		}
+
+		friend bool operator!=(const spilling_immutable_list<T>& left, const spilling_immutable_list<T>& right) {
+			return !(left == right);
+		}
+
+	private:
+		using Node = detail::spilled_segment<T>;
+
+		spilling_immutable_list(std::shared_ptr<store_type> store, std::shared_ptr<Node> head, size_type offset, size_type size) noexcept
+			: store{ std::move(store) }, head{ std::move(head) }, offset{ offset }, m_size{ size } {}
+
+		[[nodiscard]] std::shared_ptr<Node> make_node(typename store_type::segment&& data, size_type claimed) const;
+
+	private:
+		std::shared_ptr<store_type> store;
+		std::shared_ptr<Node> head;
+
+		// The position, in the first segment, of the first element of the list
+		size_type offset;
+		size_type m_size;
+	};
+
+	/*!
+	 * @brief	Constructs a new list, backed by store, from the content of the range [first, last)
+	 *
+	 * Segments are added to the store as they are filled, so that a range larger than the memory budget of the store is spilled while the list is built.
+	 * When InputIterator does not satisfy the LegacyForwardIterator concept, the range is buffered in memory first.
+	 */
+
+	template <typename T>
+	template <typename InputIterator, typename>
+	inline spilling_immutable_list<T>::spilling_immutable_list(std::shared_ptr<store_type> store, InputIterator first, InputIterator last)
+		: spilling_immutable_list{ std::move(store) }
+	{
+		if constexpr (!std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>) {
+			std::vector<T> elements(first, last);
+			*this = spilling_immutable_list<T>{ this->store, elements.cbegin(), elements.cend() };
+		} else {
+			auto count{ static_cast<size_type>(std::distance(first, last)) };
+			if (count == 0) {
+				return;
+			}
+
+			auto segmentSize{ this->store->segment_size() };
+			auto segmentCount{ (count + segmentSize - 1) / segmentSize };
+			this->offset = segmentCount * segmentSize - count;
+			this->m_size = count;
+
+			std::shared_ptr<Node>* link{ &this->head };
+			for (auto start{ this->offset }; first != last; start = 0) {
+				typename store_type::segment data(segmentSize);
+				for (auto position{ start }; position < segmentSize; ++position, ++first) {
+					data[position] = *first;
+				}
+
+				*link = this->make_node(std::move(data), start);
+				link = &(*link)->next;
+			}
+		}
+	}
+
+	/*!
+	 * @brief	Gets the first element of the container
+	 *
+	 * Calling front on an empty list is considered undefined behaviour.
+	 */
+
+	template <typename T>
+	typename inline spilling_immutable_list<T>::const_reference spilling_immutable_list<T>::front() const
+	{
+		return (*this->store->load(this->head->id))[this->offset];
+	}
+
+	/*!
+	 * @brief	Gets the ith element of the list. at is range checked.
+	 *
+	 * @exception	std::out_of_range	Thrown when index >= size().
+	 */
+
+	template <typename T>
+	typename inline spilling_immutable_list<T>::const_reference spilling_immutable_list<T>::at(size_type index) const
+	{
+		if (index >= this->m_size) {
+			throw std::out_of_range((std::stringstream() << "The list does not contain index " << index).str());
+		}
+
+		return (*this)[index];
+	}
+
+	/*!
+	 * @brief	Gets the ith element of the list.
+	 *
+	 * Costs index / segment_size() node hops and the load of a single segment.
+	 */
+
+	template <typename T>
+	typename inline spilling_immutable_list<T>::const_reference spilling_immutable_list<T>::operator[](size_type index) const
+	{
+		index += this->offset;
+
+		auto segmentSize{ this->store->segment_size() };
+		const Node* node{ this->head.get() };
+		for (; index >= segmentSize; index -= segmentSize) {
+			node = node->next.get();
+		}
+
+		return (*this->store->load(node->id))[index];
+	}
+
+	template <typename T>
+	inline spilling_immutable_list<T> spilling_immutable_list<T>::clear() const noexcept
+	{
+		return spilling_immutable_list<T>{ this->store };
+	}
+
+	/*!
+	 * @brief	Generates a new list with an element prepended to it
+	 *
+	 * When this list is the first to push in front of its first element, the element is written in the free slot before it and the new list
+	 * shares the first segment of this list, without adding a segment to the store.
+	 * Otherwise the used part of the first segment is copied in a new segment or, when the first segment is full, a new, otherwise empty, segment is created.
+	 *
+	 * @exception	std::ios_base::failure	Thrown when the backing file can't be read or written.
+	 */
+
+	template <typename T>
+	inline spilling_immutable_list<T> spilling_immutable_list<T>::push_front(const value_type& data) const
+	{
+		auto segmentSize{ this->store->segment_size() };
+
+		if (this->head && this->offset > 0) {
+			if (this->head->claim(this->offset - 1)) {
+				try {
+					this->store->write(this->head->id, this->offset - 1, data);
+				} catch (...) {
+					this->head->claimed.store(this->offset);
+					throw;
+				}
+
+				return spilling_immutable_list<T>(this->store, this->head, this->offset - 1, this->m_size + 1);
+			}
+
+			typename store_type::segment segment(segmentSize);
+			auto shared{ this->store->load(this->head->id) };
+			std::copy(shared->cbegin() + static_cast<std::ptrdiff_t>(this->offset), shared->cend(), segment.begin() + static_cast<std::ptrdiff_t>(this->offset));
+			segment[this->offset - 1] = data;
+			shared.reset();
+
+			auto node{ this->make_node(std::move(segment), this->offset - 1) };
+			node->next = this->head->next;
+
+			return spilling_immutable_list<T>(this->store, std::move(node), this->offset - 1, this->m_size + 1);
+		}
+
+		typename store_type::segment segment(segmentSize);
+		segment[segmentSize - 1] = data;
+
+		auto node{ this->make_node(std::move(segment), segmentSize - 1) };
+		node->next = this->head;
+
+		return spilling_immutable_list<T>(this->store, std::move(node), segmentSize - 1, this->m_size + 1);
+	}
+
+	/*!
+	 * @brief	Generates a new list with an the front element removed
+	 *
+	 * Never allocates nor loads a segment, as the new list shares all the segments of this list.
+	 */
+
+	template <typename T>
+	inline spilling_immutable_list<T> spilling_immutable_list<T>::pop_front() const noexcept
+	{
+		if (this->offset + 1 == this->store->segment_size()) {
+			return spilling_immutable_list<T>(this->store, this->head->next, 0, this->m_size - 1);
+		}
+
+		return spilling_immutable_list<T>(this->store, this->head, this->offset + 1, this->m_size - 1);
+	}
+
+	template <typename T>
+	inline bool spilling_immutable_list<T>::empty() const noexcept
+	{
+		return !this->m_size;
+	}
+
+	template <typename T>
+	typename inline spilling_immutable_list<T>::size_type spilling_immutable_list<T>::size() const noexcept
+	{
+		return this->m_size;
+	}
+
+	template <typename T>
+	typename inline constexpr spilling_immutable_list<T>::size_type spilling_immutable_list<T>::max_size() const noexcept
+	{
+		return std::numeric_limits<size_type>::max();
+	}
+
+	/*!
+	 * @brief	Gets the store that backs the list
+	 */
+
+	template <typename T>
+	inline const std::shared_ptr<typename spilling_immutable_list<T>::store_type>& spilling_immutable_list<T>::backing_store() const noexcept
+	{
+		return this->store;
+	}
+
+	/*!
+	 * @brief	Adds a segment to the store and creates the node that references it
+	 */
+
+	template <typename T>
+	inline std::shared_ptr<typename spilling_immutable_list<T>::Node> spilling_immutable_list<T>::make_node(typename store_type::segment&& data, size_type claimed) const
+	{
+		auto id{ this->store->add(std::move(data)) };
+
+		try {
+			return std::make_shared<Node>(this->store, id, claimed);
+		} catch (...) {
+			this->store->remove(id);
+			throw;
+		}
+	}
+
+	// SPILLING_IMMUTABLE_LIST_ITERATOR IMPLEMENTATION //
+
+	template <typename T>
+	inline spilling_immutable_list_iterator<T>& spilling_immutable_list_iterator<T>::operator++() noexcept
+	{
+		if (++this->index == this->node->store->segment_size()) {
+			this->node = this->node->next.get();
+			this->index = 0;
+			this->segment.reset();
+		}
+
+		return *this;
+	}
+
+	template <typename T>
+	inline spilling_immutable_list_iterator<T> spilling_immutable_list_iterator<T>::operator++(int) noexcept
+	{
+		spilling_immutable_list_iterator<T> previous{ *this };
+		++(*this);
+
+		return previous;
+	}
+
+	template <typename T>
+	typename inline spilling_immutable_list_iterator<T>::reference spilling_immutable_list_iterator<T>::operator*() const
+	{
+		if (!this->segment) {
+			this->segment = this->node->store->load(this->node->id);
+		}
+
+		return (*this->segment)[this->index];
+	}
+}
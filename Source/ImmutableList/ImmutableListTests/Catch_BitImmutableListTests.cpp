@@ -0,0 +1,100 @@
+// Copyright 2018 Luca Di Sera
+//		Contact: disera.luca@gmail.com
+//				 https://github.com/diseraluca
+//				 https://www.linkedin.com/in/luca-di-sera-200023167
+//
+// This code is licensed under the MIT License.
+// More informations can be found in the LICENSE file in the root folder of this repository
+
+#include "catch.hpp"
+
+#include <bit_immutable_list.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+using namespace lds;
+
+TEST_CASE("A bit_immutable_list packs its elements in words", "[bit_immutable_list]") {
+	std::vector<bool> flags{};
+	for (std::size_t index{ 0 }; index < 1000; ++index) {
+		flags.push_back(index % 3 == 0 || index % 7 == 0);
+	}
+
+	bit_immutable_list list{ flags.cbegin(), flags.cend() };
+
+	SECTION("The new list has the same elements, in the same order, of the original range") {
+		REQUIRE(list.size() == flags.size());
+		REQUIRE(std::equal(list.cbegin(), list.cend(), flags.cbegin(), flags.cend()));
+		REQUIRE(list[0] == flags[0]);
+		REQUIRE(list[999] == flags[999]);
+		REQUIRE_THROWS_AS(list.at(1000), std::out_of_range);
+	}
+
+	SECTION("push_front/pop_front prepend and remove elements across chunk boundaries") {
+		auto newList{ list };
+		auto expected{ flags };
+		for (std::size_t index{ 0 }; index < 600; ++index) {
+			newList = newList.push_front(index % 2 == 0);
+			expected.insert(expected.begin(), index % 2 == 0);
+		}
+
+		REQUIRE(std::equal(newList.cbegin(), newList.cend(), expected.cbegin(), expected.cend()));
+
+		for (std::size_t index{ 0 }; index < 900; ++index) {
+			newList = newList.pop_front();
+		}
+
+		REQUIRE(newList.size() == expected.size() - 900);
+		REQUIRE(std::equal(newList.cbegin(), newList.cend(), expected.cbegin() + 900, expected.cend()));
+		REQUIRE(list.size() == flags.size());
+	}
+
+	SECTION("insert_after/erase_after edit the elements after the given position") {
+		auto position{ std::next(list.cbegin(), 300) };
+		auto insertion{ list.insert_after(position, 5, true) };
+		auto erasion{ list.erase_after(position, std::next(position, 400)) };
+
+		auto expectedInsertion{ flags };
+		expectedInsertion.insert(expectedInsertion.begin() + 301, 5, true);
+		auto expectedErasion{ flags };
+		expectedErasion.erase(expectedErasion.begin() + 301, expectedErasion.begin() + 700);
+
+		REQUIRE(insertion.size() == expectedInsertion.size());
+		REQUIRE(std::equal(insertion.cbegin(), insertion.cend(), expectedInsertion.cbegin(), expectedInsertion.cend()));
+		REQUIRE(erasion.size() == expectedErasion.size());
+		REQUIRE(std::equal(erasion.cbegin(), erasion.cend(), expectedErasion.cbegin(), expectedErasion.cend()));
+		REQUIRE(list.erase_after(position).size() == flags.size() - 1);
+	}
+
+	SECTION("count and any inspect only the elements of the list") {
+		REQUIRE(list.count() == static_cast<std::size_t>(std::count(flags.cbegin(), flags.cend(), true)));
+		REQUIRE(list.any());
+
+		auto allFalse{ bit_immutable_list{ true, false, false }.pop_front() };
+
+		REQUIRE(allFalse.size() == 2);
+		REQUIRE_FALSE(allFalse.any());
+		REQUIRE(allFalse.count() == 0);
+	}
+
+	SECTION("push_front shares the first chunk with the list it was called on, unless another list has already done so") {
+		auto first{ list.push_front(true) };
+		auto second{ list.push_front(false) };
+
+		REQUIRE(std::next(first.cbegin()) == list.cbegin());
+		REQUIRE(std::next(second.cbegin()) != list.cbegin());
+		REQUIRE(first.front());
+		REQUIRE_FALSE(second.front());
+		REQUIRE(std::equal(std::next(first.cbegin()), first.cend(), flags.cbegin(), flags.cend()));
+		REQUIRE(std::equal(std::next(second.cbegin()), second.cend(), flags.cbegin(), flags.cend()));
+
+		auto chain{ second.push_front(true).push_front(false) };
+
+		REQUIRE(std::next(chain.cbegin(), 2) == second.cbegin());
+		REQUIRE(list == first.pop_front());
+	}
+}
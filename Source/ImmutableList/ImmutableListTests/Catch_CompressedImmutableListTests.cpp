@@ -0,0 +1,106 @@
+// Copyright 2018 Luca Di Sera
+//		Contact: disera.luca@gmail.com
+//				 https://github.com/diseraluca
+//				 https://www.linkedin.com/in/luca-di-sera-200023167
+//
+// This code is licensed under the MIT License.
+// More informations can be found in the LICENSE file in the root folder of this repository
+
+#include "catch.hpp"
+
+#include <compressed_immutable_list.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace lds;
+
+TEST_CASE("A compressed_immutable_list can be constructed from an iterator range", "[compressed_immutable_list][constructors]") {
+	std::vector<std::int64_t> timestamps{};
+	for (std::int64_t timestamp{ 1500000000000 }; timestamps.size() < 5000; timestamp += 7 + static_cast<std::int64_t>(timestamps.size() % 13)) {
+		timestamps.push_back(timestamp);
+	}
+
+	compressed_immutable_list<std::int64_t> list{ timestamps.cbegin(), timestamps.cend() };
+
+	SECTION("The new list has the same elements, in the same order, of the original range") {
+		REQUIRE(list.size() == timestamps.size());
+		REQUIRE(std::equal(list.cbegin(), list.cend(), timestamps.cbegin(), timestamps.cend()));
+	}
+
+	SECTION("Elements can be accessed by index across blocks") {
+		REQUIRE(list[0] == timestamps[0]);
+		REQUIRE(list[4321] == timestamps[4321]);
+		REQUIRE(list.at(4999) == timestamps[4999]);
+		REQUIRE_THROWS_AS(list.at(5000), std::out_of_range);
+	}
+
+	SECTION("An empty range returns an empty list") {
+		REQUIRE(compressed_immutable_list<std::int64_t>(timestamps.cbegin(), timestamps.cbegin()).empty());
+	}
+}
+
+TEST_CASE("A compressed_immutable_list stores differences of any sign and magnitude", "[compressed_immutable_list][constructors]") {
+	std::vector<std::int64_t> values{ 0, -1, 1, INT64_MAX, INT64_MIN, INT64_MAX, 42, 42, -42 };
+	compressed_immutable_list<std::int64_t> list{ values.cbegin(), values.cend() };
+
+	REQUIRE(std::equal(list.cbegin(), list.cend(), values.cbegin(), values.cend()));
+
+	compressed_immutable_list<std::uint8_t, 4> smallBlocks{ 255, 0, 255, 1, 2, 3 };
+	REQUIRE(smallBlocks.size() == 6);
+	REQUIRE(smallBlocks[2] == 255);
+	REQUIRE(smallBlocks[5] == 3);
+}
+
+TEST_CASE("compressed_immutable_list::push_front/pop_front create and return a new list with the head element added or removed", "[compressed_immutable_list][modifiers]") {
+	compressed_immutable_list<int, 16> list{};
+	std::vector<int> expected{};
+
+	for (int value{ 0 }; value < 1000; ++value) {
+		list = list.push_front(value * 3);
+		expected.insert(expected.begin(), value * 3);
+	}
+
+	SECTION("Prepending keeps the elements in order across blocks") {
+		REQUIRE(list.size() == expected.size());
+		REQUIRE(list.front() == 2997);
+		REQUIRE(std::equal(list.cbegin(), list.cend(), expected.cbegin(), expected.cend()));
+	}
+
+	SECTION("Popping removes one element at a time and leaves the original list untouched") {
+		auto popped{ list };
+		for (int count{ 0 }; count < 500; ++count) {
+			popped = popped.pop_front();
+		}
+
+		REQUIRE(popped.size() == 500);
+		REQUIRE(std::equal(popped.cbegin(), popped.cend(), expected.cbegin() + 500, expected.cend()));
+		REQUIRE(list.size() == 1000);
+	}
+
+	SECTION("push_front shares the first block with the list it was called on, unless another list has already done so") {
+		auto first{ list.push_front(3000) };
+		auto second{ list.push_front(-1) };
+
+		REQUIRE(std::next(first.cbegin()) == list.cbegin());
+		REQUIRE(std::next(second.cbegin()) != list.cbegin());
+		REQUIRE(first.front() == 3000);
+		REQUIRE(second.front() == -1);
+		REQUIRE(std::equal(std::next(first.cbegin()), first.cend(), expected.cbegin(), expected.cend()));
+		REQUIRE(std::equal(std::next(second.cbegin()), second.cend(), expected.cbegin(), expected.cend()));
+
+		auto repushed{ list.pop_front().push_front(7) };
+
+		REQUIRE(std::next(repushed.cbegin()) != list.pop_front().cbegin());
+		REQUIRE(repushed.front() == 7);
+		REQUIRE(std::equal(std::next(first.cbegin()), first.cend(), expected.cbegin(), expected.cend()));
+		REQUIRE(std::equal(std::next(repushed.cbegin()), repushed.cend(), expected.cbegin() + 1, expected.cend()));
+	}
+
+	SECTION("Popping every element returns an empty list") {
+		compressed_immutable_list<int, 16> single{ 5 };
+
+		REQUIRE(single.pop_front().empty());
+		REQUIRE(single.pop_front() == single.clear());
+	}
+}
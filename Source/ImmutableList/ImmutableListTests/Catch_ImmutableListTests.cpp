@@ -12,8 +12,50 @@
 
 #include <immutable_list.h>
 
+#include <algorithm>
+#include <any>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
 using namespace lds;
 
+TEST_CASE("An empty immutable_list does not allocate", "[immutable_list][constructors][memory]") {
+	struct NotDefaultConstructible {
+		explicit NotDefaultConstructible(int value) : value{ value } {}
+
+		int value;
+	};
+
+	SECTION("Default construction cannot throw") {
+		REQUIRE(std::is_nothrow_default_constructible_v<immutable_list<int>>);
+	}
+
+	SECTION("An empty list holds no node, and a list with one element holds a single one") {
+		immutable_list<int> empty{};
+		auto single{ empty.push_front(1) };
+
+		REQUIRE(memory_stats(empty).node_count == 0);
+		REQUIRE(memory_stats(empty).total_bytes() == 0);
+		REQUIRE(memory_stats(single).node_count == 1);
+		REQUIRE(memory_stats(single.pop_front()).node_count == 0);
+	}
+
+	SECTION("The element type does not need to be default constructible") {
+		immutable_list<NotDefaultConstructible> list{};
+		auto newList{ list.push_front(NotDefaultConstructible{ 3 }) };
+
+		REQUIRE(list.cbegin() == list.cend());
+		REQUIRE(newList.front().value == 3);
+		REQUIRE(std::next(newList.cbegin()) == newList.cend());
+	}
+}
+
 TEST_CASE("An immutable_list can be constructed from an iterator range", "[immutable_list][constructors]") {
 	int endValue{ 3 };
 
@@ -42,6 +84,19 @@ TEST_CASE("An immutable_list can be constructed from an initializer list", "[imm
 	}
 }
 
+TEST_CASE("An immutable_list constructed from a forward range lays out its nodes contiguously, in traversal order", "[immutable_list][constructors][memory]") {
+	std::vector<int> containerForRange{ 1, 2, 3, 4, 5, 6, 7, 8 };
+	immutable_list<int> list{ containerForRange.cbegin(), containerForRange.cend() };
+
+	auto first{ list.cbegin() };
+	auto second{ std::next(first) };
+	auto stride{ reinterpret_cast<std::uintptr_t>(&*second) - reinterpret_cast<std::uintptr_t>(&*first) };
+
+	for (auto previous{ first }, current{ second }; current != list.cend(); ++previous, ++current) {
+		REQUIRE(reinterpret_cast<std::uintptr_t>(&*current) - reinterpret_cast<std::uintptr_t>(&*previous) == stride);
+	}
+}
+
 TEST_CASE("immutable_list provides access methods to individual elements", "[immutable_list][element_access][exception]") {
 	immutable_list<int> list{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
 
@@ -110,6 +165,31 @@ TEST_CASE("immutable_list::push_front/emplace_front creates and returns a new li
 	}
 }
 
+TEST_CASE("immutable_list::reserve_front creates and returns an equal list whose next push_front/emplace_front take contiguous reserved memory", "[immutable_list][push_front][capacity][memory]") {
+	immutable_list<int> list{ 5 };
+	auto reservedList{ list.reserve_front(4) };
+
+	REQUIRE(reservedList == list);
+
+	auto newList{ reservedList.push_front(4).emplace_front(3).push_front(2).push_front(1) };
+
+	SECTION("The elements are prepended as with a list without a reservation") {
+		REQUIRE(newList == immutable_list<int>{ 1, 2, 3, 4, 5 });
+	}
+
+	SECTION("The prepended elements are laid out contiguously in traversal order") {
+		auto first{ newList.cbegin() };
+		auto stride{ reinterpret_cast<std::uintptr_t>(&*std::next(first)) - reinterpret_cast<std::uintptr_t>(&*first) };
+
+		REQUIRE(reinterpret_cast<std::uintptr_t>(&*std::next(first, 2)) - reinterpret_cast<std::uintptr_t>(&*std::next(first)) == stride);
+		REQUIRE(reinterpret_cast<std::uintptr_t>(&*std::next(first, 3)) - reinterpret_cast<std::uintptr_t>(&*std::next(first, 2)) == stride);
+	}
+
+	SECTION("Prepending more elements than reserved is still possible") {
+		REQUIRE(newList.push_front(0).front() == 0);
+	}
+}
+
 TEST_CASE("immutable_list::pop_front creates and returns a new list with the head element removed", "[immutable_list][pop_front][modifiers]") {
 	immutable_list<int> list{ 13 };
 	auto newList{ list.pop_front() };
@@ -122,6 +202,112 @@ TEST_CASE("immutable_list::pop_front creates and returns a new list with the hea
 		CHECK(list.size() == 1);
 		REQUIRE(newList.empty());
 	} 
+
+	SECTION("The new list contains the elements that followed the head element") {
+		immutable_list<int> longerList{ 1, 2, 3 };
+
+		REQUIRE(longerList.pop_front() == immutable_list<int>{ 2, 3 });
+	}
+}
+
+TEST_CASE("immutable_list::prepend_range/prepend create and return a new list with a range of elements prepended", "[immutable_list][modifiers][prepend_range]") {
+	immutable_list<int> list{ 4, 5, 6 };
+
+	SECTION("The elements are prepended in the order of the range and the original list is shared") {
+		std::vector<int> burst{ 1, 2, 3 };
+		auto prepended{ list.prepend_range(burst.cbegin(), burst.cend()) };
+
+		REQUIRE(prepended == immutable_list<int>{ 1, 2, 3, 4, 5, 6 });
+		REQUIRE(prepended.size() == 6);
+		REQUIRE(&*std::next(prepended.cbegin(), 3) == &list.front());
+		REQUIRE(list == immutable_list<int>{ 4, 5, 6 });
+	}
+
+	SECTION("The new nodes are laid out as the nodes of a list constructed from the same range") {
+		std::vector<int> burst(1000);
+		std::iota(burst.begin(), burst.end(), 0);
+
+		auto prepended{ immutable_list<int>{}.prepend_range(burst.cbegin(), burst.cend()) };
+
+		REQUIRE(fragmentation(prepended) == fragmentation(immutable_list<int>{ burst.cbegin(), burst.cend() }));
+	}
+
+	SECTION("Prepending on an rvalue takes the nodes of the consumed list") {
+		auto headAddress{ &list.front() };
+		auto prepended{ std::move(list).prepend({ 1, 2, 3 }) };
+
+		REQUIRE(list.empty());
+		REQUIRE(&*std::next(prepended.cbegin(), 3) == headAddress);
+		REQUIRE(memory_stats(prepended).shared_bytes == 0);
+	}
+
+	SECTION("Prepending an empty range returns an equal list") {
+		REQUIRE(list.prepend({}) == list);
+	}
+}
+
+TEST_CASE("immutable_list::replace_front creates and returns a new list with the head element replaced", "[immutable_list][replace_front][modifiers]") {
+	immutable_list<int> list{ 1, 2, 3 };
+
+	SECTION("The new list has the same size and the same elements after the head") {
+		auto newList{ list.replace_front(10) };
+
+		REQUIRE(newList == immutable_list<int>{ 10, 2, 3 });
+		REQUIRE(list == immutable_list<int>{ 1, 2, 3 });
+	}
+
+	SECTION("Replacing the head of a list that is not shared reuses its node") {
+		auto uniqueList{ list.pop_front().push_front(1) };
+		auto headAddress{ &uniqueList.front() };
+
+		auto newList{ std::move(uniqueList).replace_front(10) };
+
+		REQUIRE(&newList.front() == headAddress);
+		REQUIRE(newList == immutable_list<int>{ 10, 2, 3 });
+	}
+
+	SECTION("Replacing the head in place drops the snapshot of the old elements") {
+		auto uniqueList{ list.pop_front().push_front(1) };
+		auto frozen{ uniqueList.freeze() };
+
+		auto newList{ std::move(uniqueList).replace_front(10) };
+
+		REQUIRE(newList.freeze()[0] == 10);
+		REQUIRE(frozen[0] == 1);
+	}
+
+	SECTION("Replacing the head of a shared list leaves the other lists untouched") {
+		auto sharedList{ list };
+		auto newList{ std::move(sharedList).replace_front(10) };
+
+		REQUIRE(newList.front() == 10);
+		REQUIRE(list.front() == 1);
+	}
+}
+
+TEST_CASE("Modifiers of an immutable_list whose elements can be constructed from anything keep the right size", "[immutable_list][modifiers]") {
+	// Braces would wrap the lists of std::any in a new list trough the initializer_list constructor
+	auto list(immutable_list<std::any>{}.push_front(std::any{ 1 }).push_front(std::any{ 2 }).push_front(std::any{ 3 }));
+
+	REQUIRE(list.size() == 3);
+	REQUIRE(std::any_cast<int>(list.front()) == 3);
+	REQUIRE(list.pop_front().size() == 2);
+	REQUIRE(list.replace_front(std::any{ 4 }).size() == 3);
+	REQUIRE(std::move(list).replace_front(std::any{ 4 }).size() == 3);
+
+	immutable_list<std::any> other{ std::any{ 1 }, std::any{ 2 } };
+	auto inserted(other.insert_after(other.cbegin(), std::any{ 5 }));
+
+	REQUIRE(inserted.size() == 3);
+	REQUIRE(std::any_cast<int>(*std::next(inserted.cbegin())) == 5);
+	REQUIRE(inserted.erase_after(inserted.cbegin()).size() == 2);
+	REQUIRE(inserted.drop(1).size() == 2);
+	REQUIRE(inserted.take(2).size() == 2);
+
+	auto copy(inserted);
+	copy = std::move(other);
+
+	REQUIRE(copy.size() == 2);
 }
 
 // TODO : Find a more elegant and readable solution to test the different overloads
@@ -208,6 +394,58 @@ TEST_CASE("immutable_list::insert_after/emplace_after provides a way to create a
 	}
 }
 
+TEST_CASE("immutable_list::insert_after stores counted insertions as a single run that is split only where needed", "[immutable_list][modifiers][insert_after][erase_after]") {
+	immutable_list<int> list{ 1, 2, 3 };
+	auto paddedList{ list.insert_after(list.cbegin(), 1000, 0) };
+
+	SECTION("The run is expanded by the iterators") {
+		std::vector<int> expected(1002, 0);
+		expected.front() = 1;
+		expected[1001] = 2;
+		expected.push_back(3);
+
+		REQUIRE(paddedList.size() == expected.size());
+		REQUIRE(std::equal(paddedList.cbegin(), paddedList.cend(), expected.cbegin(), expected.cend()));
+	}
+
+	SECTION("All the elements of the run share the same storage") {
+		REQUIRE(&paddedList[1] == &paddedList[1000]);
+	}
+
+	SECTION("Inserting inside the run splits it around the new elements") {
+		auto splitList{ paddedList.insert_after(std::next(paddedList.cbegin(), 500), 7) };
+
+		REQUIRE(splitList.size() == paddedList.size() + 1);
+		REQUIRE(splitList[500] == 0);
+		REQUIRE(splitList[501] == 7);
+		REQUIRE(splitList[502] == 0);
+		REQUIRE(std::count(splitList.cbegin(), splitList.cend(), 0) == 1000);
+	}
+
+	SECTION("Erasing inside the run removes only the erased elements") {
+		auto singleErasion{ paddedList.erase_after(std::next(paddedList.cbegin(), 500)) };
+		auto rangeErasion{ paddedList.erase_after(std::next(paddedList.cbegin(), 10), std::next(paddedList.cbegin(), 991)) };
+
+		REQUIRE(singleErasion.size() == paddedList.size() - 1);
+		REQUIRE(std::count(singleErasion.cbegin(), singleErasion.cend(), 0) == 999);
+
+		std::vector<int> expected(20, 0);
+		expected.insert(expected.begin(), 1);
+		expected.insert(expected.end(), { 2, 3 });
+
+		REQUIRE(rangeErasion.size() == paddedList.size() - 980);
+		REQUIRE(std::equal(rangeErasion.cbegin(), rangeErasion.cend(), expected.cbegin(), expected.cend()));
+	}
+
+	SECTION("Popping the front of a run removes a single element") {
+		auto runList{ paddedList.pop_front() };
+
+		REQUIRE(runList.size() == paddedList.size() - 1);
+		REQUIRE(runList.pop_front().size() == paddedList.size() - 2);
+		REQUIRE(std::count(runList.pop_front().cbegin(), runList.pop_front().cend(), 0) == 999);
+	}
+}
+
 TEST_CASE("immutable_list::erase_after creates and returns a new list with one or more elements removed", "[immutable_list][modifiers][erase_after]") {
 	int erasionPivotValue{ 4 };
 	immutable_list<int> originalList{ 1, 2, 3, 4, 5, 6, 7, 8 };
@@ -252,4 +490,765 @@ TEST_CASE("immutable_lists can be compared for equality and inequality", "[immut
 
 		REQUIRE(list == list2);
 	}
-}
\ No newline at end of file
+}
+
+struct CopyCountedMessage {
+	explicit CopyCountedMessage(int id) : id{ id } {}
+	CopyCountedMessage(const CopyCountedMessage& other) : id{ other.id }, payload{ other.payload } { ++copies; }
+	CopyCountedMessage(CopyCountedMessage&& other) =default;
+
+	static inline int copies{ 0 };
+
+	int id;
+	std::array<char, 2048> payload{};
+};
+
+namespace lds {
+	template <>
+	struct boxed_payload<CopyCountedMessage> : std::true_type {};
+}
+
+TEST_CASE("Modifiers of an immutable_list with boxed elements share the elements of the original list", "[immutable_list][modifiers][memory]") {
+	std::vector<CopyCountedMessage> messages{};
+	for (int id{ 0 }; id < 100; ++id) {
+		messages.emplace_back(id);
+	}
+
+	immutable_list<CopyCountedMessage> list{ messages.cbegin(), messages.cend() };
+	auto position{ std::next(list.cbegin(), 90) };
+
+	CopyCountedMessage::copies = 0;
+
+	auto insertion{ list.insert_after(position, CopyCountedMessage{ -1 }) };
+	auto emplacement{ list.emplace_after(position, -2) };
+	auto erasion{ list.erase_after(position) };
+
+	REQUIRE(CopyCountedMessage::copies == 0);
+
+	REQUIRE(insertion.size() == 101);
+	REQUIRE(std::next(insertion.cbegin(), 91)->id == -1);
+	REQUIRE(std::next(emplacement.cbegin(), 91)->id == -2);
+	REQUIRE(std::next(erasion.cbegin(), 91)->id == 92);
+	REQUIRE(&*std::next(insertion.cbegin(), 50) == &*std::next(list.cbegin(), 50));
+}
+
+TEST_CASE("An immutable_list can store move-only elements", "[immutable_list][constructors][modifiers]") {
+	std::vector<std::unique_ptr<int>> handles{};
+	for (int value{ 0 }; value < 10; ++value) {
+		handles.push_back(std::make_unique<int>(value));
+	}
+
+	immutable_list<std::unique_ptr<int>> list{ std::make_move_iterator(handles.begin()), std::make_move_iterator(handles.end()) };
+
+	SECTION("Construction from a range of move_iterators moves the elements in the list") {
+		REQUIRE(list.size() == 10);
+		REQUIRE(*list.front() == 0);
+		REQUIRE(*list[9] == 9);
+		REQUIRE(handles.front() == nullptr);
+	}
+
+	SECTION("push_front, emplace_front and pop_front never copy an element") {
+		auto pushed{ list.push_front(std::make_unique<int>(-1)) };
+		auto emplaced{ pushed.emplace_front(new int{ -2 }) };
+		auto popped{ emplaced.pop_front().pop_front().pop_front() };
+
+		REQUIRE(emplaced.size() == 12);
+		REQUIRE(*emplaced.front() == -2);
+		REQUIRE(*std::next(emplaced.cbegin())->get() == -1);
+		REQUIRE(popped.front().get() == list[1].get());
+	}
+
+	SECTION("replace_front replaces the first element with an rvalue") {
+		auto replaced{ list.replace_front(std::make_unique<int>(42)) };
+
+		REQUIRE(*replaced.front() == 42);
+		REQUIRE(*list.front() == 0);
+		REQUIRE(replaced[1].get() == list[1].get());
+	}
+}
+
+TEST_CASE("memory_stats reports the memory held by one or more immutable_list versions", "[immutable_list][memory]") {
+	immutable_list<int> base{};
+	for (int value{ 0 }; value < 10; ++value) {
+		base = base.push_front(value);
+	}
+
+	auto first{ base.push_front(100).push_front(101) };
+	auto second{ base.push_front(200) };
+
+	SECTION("A list that shares no node owns all of its memory") {
+		auto stats{ memory_stats(immutable_list<int>{ 1, 2, 3 }) };
+
+		REQUIRE(stats.node_count == 3);
+		REQUIRE(stats.shared_bytes == 0);
+		REQUIRE(stats.exclusive_bytes == stats.total_bytes());
+	}
+
+	SECTION("The nodes from the first shared one are reported as shared") {
+		auto stats{ memory_stats(first) };
+		auto baseStats{ memory_stats(base) };
+
+		REQUIRE(stats.node_count == 12);
+		REQUIRE(baseStats.exclusive_bytes == 0);
+		REQUIRE(stats.shared_bytes == baseStats.shared_bytes);
+		REQUIRE(stats.exclusive_bytes * 5 == stats.shared_bytes);
+	}
+
+	SECTION("A set of versions accounts for each node once") {
+		auto firstStats{ memory_stats(first) };
+
+		std::vector<immutable_list<int>> versions{ base, first, second };
+		auto stats{ memory_stats(versions.cbegin(), versions.cend()) };
+
+		REQUIRE(stats.node_count == 13);
+		REQUIRE(stats.total_bytes() == firstStats.total_bytes() / 12 * 13);
+		REQUIRE(stats.exclusive_bytes == 0);
+	}
+
+	SECTION("The nodes of a set of versions are exclusive only if no list outside of the set holds them") {
+		auto firstStats{ memory_stats(first) };
+
+		std::vector<immutable_list<int>> versions{ base, std::move(first), std::move(second) };
+		auto stats{ memory_stats(versions.cbegin(), versions.cend()) };
+
+		REQUIRE(stats.node_count == 13);
+		REQUIRE(stats.exclusive_bytes == firstStats.exclusive_bytes / 2 * 3);
+		REQUIRE(stats.shared_bytes == firstStats.shared_bytes);
+
+		base = immutable_list<int>{};
+		auto releasedStats{ memory_stats(versions.cbegin(), versions.cend()) };
+
+		REQUIRE(releasedStats.exclusive_bytes == releasedStats.total_bytes());
+		REQUIRE(releasedStats.total_bytes() == stats.total_bytes());
+	}
+}
+
+TEST_CASE("compact generates an equal list whose nodes are contiguous in traversal order", "[immutable_list][memory]") {
+	std::vector<std::vector<char>> unrelatedAllocations{};
+	immutable_list<int> scattered{};
+	for (int value{ 0 }; value < 200; ++value) {
+		scattered = scattered.push_front(value);
+		unrelatedAllocations.emplace_back(1024);
+	}
+	scattered = scattered.insert_after(std::next(scattered.cbegin(), 50), 10, -1);
+
+	std::vector<int> elements{ scattered.cbegin(), scattered.cend() };
+	immutable_list<int> fresh{ elements.cbegin(), elements.cend() };
+
+	auto compacted{ compact(scattered) };
+
+	SECTION("The compacted list is equal to the original one and shares no memory with it") {
+		REQUIRE(compacted == scattered);
+		REQUIRE(compacted.size() == scattered.size());
+		REQUIRE(memory_stats(compacted).shared_bytes == 0);
+	}
+
+	SECTION("The compacted list is as fragmented as a freshly built one") {
+		REQUIRE(fragmentation(compacted) <= fragmentation(fresh));
+		REQUIRE(fragmentation(compacted) < fragmentation(scattered));
+		REQUIRE(fragmentation(immutable_list<int>{ 1 }) == 0.0);
+	}
+
+	SECTION("compact_async compacts on a background thread") {
+		REQUIRE(compact_async(scattered).get() == scattered);
+
+		auto version{ std::make_shared<const immutable_list<int>>(scattered) };
+		REQUIRE(compact_async(version).get());
+		REQUIRE(*version == scattered);
+		REQUIRE(fragmentation(*version) == fragmentation(compacted));
+	}
+}
+
+TEST_CASE("compact_versions relocates a set of versions keeping their shared nodes shared", "[immutable_list][memory]") {
+	std::vector<int> elements(100);
+	std::iota(elements.begin(), elements.end(), 0);
+
+	immutable_list<int> base{ elements.cbegin(), elements.cend() };
+	std::vector<immutable_list<int>> versions{ base, base.push_front(-1), base.push_front(-2).push_front(-3), immutable_list<int>{}, base.pop_front() };
+
+	auto result{ compact_versions(versions.cbegin(), versions.cend()) };
+
+	SECTION("The relocated versions are equal to the original ones") {
+		REQUIRE(result.versions.size() == versions.size());
+		REQUIRE(std::equal(result.versions.cbegin(), result.versions.cend(), versions.cbegin(), versions.cend()));
+	}
+
+	SECTION("Each shared node is relocated once") {
+		auto originalStats{ memory_stats(versions.cbegin(), versions.cend()) };
+		auto relocatedStats{ memory_stats(result.versions.cbegin(), result.versions.cend()) };
+
+		REQUIRE(relocatedStats.node_count == originalStats.node_count);
+		REQUIRE(relocatedStats.total_bytes() == originalStats.total_bytes());
+		REQUIRE(&*std::next(result.versions[1].cbegin()) == &*result.versions[0].cbegin());
+		REQUIRE(result.bytes_saved == originalStats.total_bytes() / 103 * (100 + 101 + 102 + 99 - 103));
+	}
+
+	SECTION("The path traversed by most versions is laid out in traversal order") {
+		auto& shared{ result.versions[0] };
+		for (auto position{ std::next(shared.cbegin()) }; std::next(position) != shared.cend(); ++position) {
+			REQUIRE(&*position < &*std::next(position));
+		}
+
+		REQUIRE(fragmentation(shared) == fragmentation(compact(base)));
+	}
+}
+
+TEST_CASE("immutable_list::freeze returns a contiguous snapshot of the list", "[immutable_list][snapshots]") {
+	std::vector<int> elements(1000);
+	std::iota(elements.begin(), elements.end(), 0);
+
+	immutable_list<int> list{ elements.cbegin(), elements.cend() };
+	auto frozen{ list.freeze() };
+
+	SECTION("The snapshot has the same elements, stored contiguously") {
+		REQUIRE(frozen.size() == list.size());
+		REQUIRE(std::equal(frozen.cbegin(), frozen.cend(), list.cbegin(), list.cend()));
+		REQUIRE(frozen[999] == 999);
+		REQUIRE(frozen.at(500) == 500);
+		REQUIRE(frozen.data() + 999 == &frozen[999]);
+		REQUIRE(frozen.cend() - frozen.cbegin() == 1000);
+		REQUIRE_THROWS_AS(frozen.at(1000), std::out_of_range);
+	}
+
+	SECTION("Freezing the list again, or a copy of it, reuses the cached snapshot") {
+		auto copy{ list };
+
+		REQUIRE(list.freeze().data() == frozen.data());
+		REQUIRE(copy.freeze().data() == frozen.data());
+		REQUIRE(list.push_front(-1).freeze().data() != frozen.data());
+	}
+
+	SECTION("Modifiers that edit an rvalue list in place do not leave a stale snapshot behind") {
+		immutable_list<int> small{ 1, 2, 3, 4 };
+		auto before{ small.freeze() };
+
+		small = std::move(small).replace_front(99);
+		REQUIRE(small.freeze()[0] == 99);
+
+		auto position{ small.cbegin() };
+		small = std::move(small).insert_after(position, 42);
+		small = std::move(small).erase_after(std::next(small.cbegin(), 2));
+
+		auto after{ small.freeze() };
+		REQUIRE(std::equal(after.cbegin(), after.cend(), small.cbegin(), small.cend()));
+		REQUIRE(after[1] == 42);
+		REQUIRE(before[0] == 1);
+	}
+
+	SECTION("thaw converts the snapshot back into an equal list") {
+		REQUIRE(frozen.thaw() == list);
+		REQUIRE(immutable_list<int>{}.freeze().empty());
+		REQUIRE(frozen_list<int>{}.thaw().empty());
+	}
+}
+
+TEST_CASE("Modifiers that edit the list after its first element copy only the nodes up to the edited position", "[immutable_list][modifiers][memory]") {
+	std::vector<int> elements(10000);
+	std::iota(elements.begin(), elements.end(), 0);
+
+	immutable_list<int> list{ elements.cbegin(), elements.cend() };
+	auto position{ std::next(list.cbegin(), 2) };
+
+	auto insertion{ list.insert_after(position, { -1, -2 }) };
+	auto emplacement{ list.emplace_after(position, -1) };
+	auto erasion{ list.erase_after(position, std::next(position, 3)) };
+
+	auto nodeBytes{ memory_stats(list).total_bytes() / list.size() };
+
+	REQUIRE(memory_stats(insertion).exclusive_bytes == nodeBytes * 5);
+	REQUIRE(memory_stats(emplacement).exclusive_bytes == nodeBytes * 4);
+	REQUIRE(memory_stats(erasion).exclusive_bytes == nodeBytes * 3);
+
+	REQUIRE(insertion.size() == 10002);
+	REQUIRE(emplacement.size() == 10001);
+	REQUIRE(erasion.size() == 9998);
+	REQUIRE(*std::next(erasion.cbegin(), 3) == 5);
+}
+
+TEST_CASE("apply_edits applies a sorted batch of edits in a single pass", "[immutable_list][modifiers]") {
+	std::vector<int> elements(1000);
+	std::iota(elements.begin(), elements.end(), 0);
+
+	immutable_list<int> list{ elements.cbegin(), elements.cend() };
+	auto runs{ list.insert_after(std::next(list.cbegin(), 9), 20, 7) };
+
+	std::vector<int> inserted{ -10, -11, -12 };
+	std::vector<list_edit<int>> edits{
+		list_edit<int>::insert(0, -1),
+		list_edit<int>::replace(3, -3),
+		list_edit<int>::erase(5, 2),
+		list_edit<int>::insert(15, inserted.cbegin(), inserted.cend()),
+		list_edit<int>::erase(15),
+		list_edit<int>::replace(20, -20)
+	};
+
+	SECTION("The new list has all the edits applied, while the original one is untouched") {
+		auto edited{ apply_edits(list, edits) };
+
+		auto expected{ elements };
+		expected[20] = -20;
+		expected.erase(expected.begin() + 15);
+		expected.insert(expected.begin() + 15, inserted.cbegin(), inserted.cend());
+		expected.erase(expected.begin() + 5, expected.begin() + 7);
+		expected[3] = -3;
+		expected.insert(expected.begin(), -1);
+
+		REQUIRE(edited.size() == expected.size());
+		REQUIRE(std::equal(edited.cbegin(), edited.cend(), expected.cbegin(), expected.cend()));
+		REQUIRE(std::equal(list.cbegin(), list.cend(), elements.cbegin(), elements.cend()));
+	}
+
+	SECTION("Only the nodes up to the last edited position are copied") {
+		auto edited{ apply_edits(list, edits) };
+		auto nodeBytes{ memory_stats(list).total_bytes() / list.size() };
+
+		REQUIRE(memory_stats(edited).exclusive_bytes == nodeBytes * 22);
+	}
+
+	SECTION("Edits inside runs split the runs only where needed") {
+		auto edited{ apply_edits(runs, { list_edit<int>::erase(12, 3), list_edit<int>::replace(20, 0) }) };
+
+		auto expected{ elements };
+		expected.insert(expected.begin() + 10, 20, 7);
+		expected[20] = 0;
+		expected.erase(expected.begin() + 12, expected.begin() + 15);
+
+		REQUIRE(std::equal(edited.cbegin(), edited.cend(), expected.cbegin(), expected.cend()));
+	}
+
+	SECTION("Unsorted or out of range edits are rejected") {
+		REQUIRE_THROWS_AS(apply_edits(list, { list_edit<int>::erase(10, 5), list_edit<int>::replace(12, 0) }), std::invalid_argument);
+		REQUIRE_THROWS_AS(apply_edits(list, { list_edit<int>::erase(999, 2) }), std::out_of_range);
+		REQUIRE_THROWS_AS(apply_edits(list, { list_edit<int>::erase(1, std::numeric_limits<std::size_t>::max()) }), std::out_of_range);
+		REQUIRE(apply_edits(list, { list_edit<int>::insert(1000, 1000) }).size() == 1001);
+	}
+}
+
+TEST_CASE("immutable_list::transient builds a list in place and turns it into an immutable_list", "[immutable_list][transient]") {
+	immutable_list<int>::transient builder{};
+
+	SECTION("push_front and push_back add elements at both ends") {
+		for (int value{ 0 }; value < 5; ++value) {
+			builder.push_back(value);
+			builder.push_front(-value - 1);
+		}
+		builder.emplace_back(5);
+
+		auto list{ builder.persistent() };
+
+		REQUIRE(list == immutable_list<int>{ -5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5 });
+		REQUIRE(list.size() == 11);
+		REQUIRE(builder.empty());
+	}
+
+	SECTION("insert_after and erase_after edit the transient in place") {
+		builder.push_back(1);
+		builder.push_back(3);
+		builder.insert_after(builder.cbegin(), 2);
+		builder.insert_after(std::next(builder.cbegin(), 2), 4);
+		builder.erase_after(builder.cbegin());
+		builder.push_back(5);
+		builder.pop_front();
+
+		REQUIRE(builder.size() == 3);
+		REQUIRE(builder.persistent() == immutable_list<int>{ 3, 4, 5 });
+	}
+
+	SECTION("A transient created from a list does not modify it") {
+		immutable_list<int> original{ 1, 2, 3 };
+		immutable_list<int>::transient copy{ original };
+		copy.push_back(4);
+		copy.pop_front();
+
+		REQUIRE(copy.persistent() == immutable_list<int>{ 2, 3, 4 });
+		REQUIRE(original == immutable_list<int>{ 1, 2, 3 });
+	}
+
+	SECTION("Long lists can be built and dropped") {
+		for (int value{ 0 }; value < 1000000; ++value) {
+			builder.push_back(value);
+		}
+
+		auto list{ builder.persistent() };
+
+		REQUIRE(list.size() == 1000000);
+		REQUIRE(*std::next(list.cbegin(), 999999) == 999999);
+	}
+}
+
+TEST_CASE("Modifiers called on an rvalue list reuse the nodes that no other list holds", "[immutable_list][modifiers][memory]") {
+	std::vector<int> elements(1000);
+	std::iota(elements.begin(), elements.end(), 0);
+
+	immutable_list<int> list{ elements.cbegin(), elements.cend() };
+	auto nodeBytes{ memory_stats(list).total_bytes() / list.size() };
+
+	SECTION("A uniquely owned list is edited in place") {
+		auto position{ std::next(list.cbegin(), 500) };
+		auto insertion{ std::move(list).insert_after(position, -1) };
+
+		REQUIRE(memory_stats(insertion).total_bytes() == nodeBytes * 1001);
+		REQUIRE(insertion.size() == 1001);
+		REQUIRE(*std::next(insertion.cbegin(), 501) == -1);
+		REQUIRE(*std::next(insertion.cbegin(), 502) == 501);
+		REQUIRE(list.empty());
+
+		auto erasion{ std::move(insertion).erase_after(position, std::next(position, 3)) };
+
+		REQUIRE(erasion.size() == 999);
+		REQUIRE(*std::next(erasion.cbegin(), 501) == 502);
+		REQUIRE(memory_stats(erasion).total_bytes() == nodeBytes * 999);
+	}
+
+	SECTION("The nodes shared with another list are copied from the first shared one") {
+		auto shared{ list.pop_front().pop_front() };
+		auto owner{ list.push_front(-1) };
+		list = immutable_list<int>{};
+
+		auto ownedElement{ &*std::next(owner.cbegin(), 2) };
+		auto position{ std::next(owner.cbegin(), 10) };
+		auto emplacement{ std::move(owner).emplace_after(position, -2) };
+
+		REQUIRE(&*std::next(emplacement.cbegin(), 2) == ownedElement);
+		REQUIRE(&*std::next(emplacement.cbegin(), 3) != &shared.front());
+		REQUIRE(memory_stats(emplacement).exclusive_bytes == nodeBytes * 12);
+		REQUIRE(*std::next(emplacement.cbegin(), 11) == -2);
+		REQUIRE(emplacement.size() == 1002);
+		REQUIRE(shared.size() == 998);
+		REQUIRE(std::equal(shared.cbegin(), shared.cend(), std::next(elements.cbegin(), 2), elements.cend()));
+	}
+
+	SECTION("Erasing nodes that another list still holds shares the suffix instead of taking it") {
+		auto tail{ list.pop_front().pop_front().pop_front() };
+		auto owner{ tail.push_front(-2).push_front(-1) };
+		list = immutable_list<int>{};
+
+		auto erasion{ std::move(owner).erase_after(owner.cbegin(), std::next(owner.cbegin(), 3)) };
+
+		REQUIRE(erasion.size() == 997);
+		REQUIRE(erasion.front() == -1);
+		REQUIRE(&*std::next(erasion.cbegin()) == &*std::next(tail.cbegin()));
+		REQUIRE(std::equal(tail.cbegin(), tail.cend(), std::next(elements.cbegin(), 3), elements.cend()));
+	}
+
+	SECTION("Editing a frozen list in place drops the snapshots of the edited nodes") {
+		auto frozen{ list.freeze() };
+		auto position{ std::next(list.cbegin(), 500) };
+
+		auto insertion{ std::move(list).insert_after(position, -1) };
+		auto erasion{ std::move(insertion).erase_after(std::next(position), std::next(position, 3)) };
+		auto refrozen{ erasion.freeze() };
+
+		REQUIRE(erasion.size() == 1000);
+		REQUIRE(refrozen[501] == -1);
+		REQUIRE(std::equal(refrozen.cbegin(), refrozen.cend(), erasion.cbegin(), erasion.cend()));
+		REQUIRE(std::equal(frozen.cbegin(), frozen.cend(), elements.cbegin(), elements.cend()));
+	}
+}
+
+TEST_CASE("Moving an immutable_list transfers its nodes without sharing them", "[immutable_list][constructors][modifiers]") {
+	immutable_list<int> list{ 1, 2, 3 };
+	auto headAddress{ &list.front() };
+
+	SECTION("The move constructor and assignment leave the source list empty") {
+		auto moved{ std::move(list) };
+
+		REQUIRE(list.empty());
+		REQUIRE(&moved.front() == headAddress);
+		REQUIRE(memory_stats(moved).shared_bytes == 0);
+
+		list = std::move(moved);
+
+		REQUIRE(moved.empty());
+		REQUIRE(list == immutable_list<int>{ 1, 2, 3 });
+		REQUIRE(memory_stats(list).shared_bytes == 0);
+	}
+
+	SECTION("Chained rvalue modifiers do not share the nodes with the intermediate lists") {
+		auto chained{ std::move(list).push_front(0).push_front(-1).emplace_front(-2).pop_front() };
+
+		REQUIRE(list.empty());
+		REQUIRE(chained == immutable_list<int>{ -1, 0, 1, 2, 3 });
+		REQUIRE(&*std::next(chained.cbegin(), 2) == headAddress);
+		REQUIRE(memory_stats(chained).shared_bytes == 0);
+	}
+
+	SECTION("pop_front on an rvalue shortens a front run that is not shared") {
+		immutable_list<int> run{ 1 };
+		run = std::move(run).insert_after(run.cbegin(), 3, 7).pop_front();
+
+		auto popped{ std::move(run).pop_front() };
+
+		REQUIRE(popped == immutable_list<int>{ 7, 7 });
+		REQUIRE(memory_stats(popped).node_count == 1);
+	}
+
+	SECTION("pop_front on an rvalue drops the snapshot of the run it shortens") {
+		immutable_list<int> run{ 1 };
+		run = std::move(run).insert_after(run.cbegin(), 3, 7).pop_front();
+		auto frozen{ run.freeze() };
+
+		auto popped{ std::move(run).pop_front() };
+		auto refilled{ std::move(popped).insert_after(popped.cbegin(), 8) };
+
+		REQUIRE(refilled == immutable_list<int>{ 7, 8, 7 });
+		REQUIRE(refilled.freeze()[1] == 8);
+		REQUIRE(frozen[1] == 7);
+	}
+
+	SECTION("rvalue modifiers on a shared list leave the other lists untouched") {
+		auto shared{ list };
+		auto popped{ std::move(shared).pop_front().push_front(10) };
+
+		REQUIRE(popped == immutable_list<int>{ 10, 2, 3 });
+		REQUIRE(list == immutable_list<int>{ 1, 2, 3 });
+	}
+}
+
+struct PinnedCounter {
+	explicit PinnedCounter(int value) : value{ value } {}
+	PinnedCounter(const PinnedCounter& other) =delete;
+	PinnedCounter(PinnedCounter&& other) =delete;
+
+	int value;
+	std::mutex mutex;
+};
+
+struct PinnedPoint {
+	PinnedPoint(int x, int y) : x{ x }, y{ y }, mutex{} {}
+	PinnedPoint(const PinnedPoint& other) =delete;
+	PinnedPoint(PinnedPoint&& other) =delete;
+
+	int x;
+	int y;
+	std::mutex mutex;
+};
+
+struct MoveCountedMessage {
+	explicit MoveCountedMessage(int id) : id{ id } {}
+	MoveCountedMessage(const MoveCountedMessage& other) =default;
+	MoveCountedMessage(MoveCountedMessage&& other) noexcept : id{ other.id } { ++moves; }
+
+	static inline int moves{ 0 };
+
+	int id;
+};
+
+TEST_CASE("immutable_list::emplace_front/emplace_after construct the element directly in its node", "[immutable_list][modifiers][emplace_front][emplace_after]") {
+	SECTION("Elements that can be neither copied nor moved can be emplaced") {
+		auto counters{ immutable_list<PinnedCounter>{}.emplace_front(1).emplace_front(2) };
+		auto points{ immutable_list<PinnedPoint>{}.emplace_front(1, 2) };
+
+		REQUIRE(counters.size() == 2);
+		REQUIRE(counters.front().value == 2);
+		REQUIRE(std::next(counters.cbegin())->value == 1);
+		REQUIRE(points.front().y == 2);
+	}
+
+	SECTION("Elements are direct initialized when T has a matching constructor") {
+		auto vectors{ immutable_list<std::vector<int>>{}.emplace_front(3, 1) };
+
+		REQUIRE(vectors.front() == std::vector<int>{ 1, 1, 1 });
+	}
+
+	SECTION("Elements are list initialized when T is an aggregate without a matching constructor") {
+		auto pairs{ immutable_list<std::array<int, 2>>{}.emplace_front(1, 2) };
+
+		REQUIRE(pairs.front() == std::array<int, 2>{ 1, 2 });
+	}
+
+	SECTION("Emplacing does not move the element") {
+		immutable_list<MoveCountedMessage> list{};
+		MoveCountedMessage::moves = 0;
+
+		list = std::move(list).emplace_front(1).emplace_front(0);
+		auto emplacement{ list.emplace_after(list.cbegin(), 2) };
+		auto inPlace{ std::move(list).emplace_after(list.cbegin(), 3) };
+
+		REQUIRE(MoveCountedMessage::moves == 0);
+		REQUIRE(std::next(emplacement.cbegin())->id == 2);
+		REQUIRE(std::next(inPlace.cbegin())->id == 3);
+	}
+
+	SECTION("A transient emplaces its elements in place") {
+		immutable_list<PinnedPoint>::transient builder{};
+		builder.emplace_back(1, 2);
+		builder.emplace_front(0, 1);
+
+		auto points{ builder.persistent() };
+
+		REQUIRE(points.size() == 2);
+		REQUIRE(points.front().x == 0);
+		REQUIRE(std::next(points.cbegin())->y == 2);
+	}
+}
+
+TEST_CASE("immutable_list::take/drop/split_at/reverse and concat share as many nodes as possible", "[immutable_list][modifiers][memory]") {
+	std::vector<int> elements(1000);
+	std::iota(elements.begin(), elements.end(), 0);
+
+	immutable_list<int> list{ elements.cbegin(), elements.cend() };
+	auto nodeBytes{ memory_stats(list).total_bytes() / list.size() };
+
+	SECTION("drop shares the whole suffix") {
+		auto dropped{ list.drop(900) };
+
+		REQUIRE(dropped.size() == 100);
+		REQUIRE(&dropped.front() == &*std::next(list.cbegin(), 900));
+		REQUIRE(memory_stats(dropped).exclusive_bytes == 0);
+		REQUIRE(list.drop(1000).empty());
+		REQUIRE(list.drop(2000).empty());
+	}
+
+	SECTION("take copies only the prefix") {
+		auto taken{ list.take(10) };
+
+		REQUIRE(taken.size() == 10);
+		REQUIRE(std::equal(taken.cbegin(), taken.cend(), elements.cbegin(), std::next(elements.cbegin(), 10)));
+		REQUIRE(memory_stats(taken).total_bytes() == nodeBytes * 10);
+		REQUIRE(list.take(0).empty());
+		REQUIRE(list.take(2000) == list);
+	}
+
+	SECTION("split_at returns the copied prefix and the shared suffix") {
+		auto [prefix, suffix] = list.split_at(300);
+
+		REQUIRE(prefix == list.take(300));
+		REQUIRE(suffix == list.drop(300));
+		REQUIRE(&suffix.front() == &*std::next(list.cbegin(), 300));
+	}
+
+	SECTION("A run is split where needed") {
+		immutable_list<int> runs{ 1 };
+		runs = runs.insert_after(runs.cbegin(), 5, 7);
+
+		auto [prefix, suffix] = runs.split_at(3);
+
+		REQUIRE(prefix == immutable_list<int>{ 1, 7, 7 });
+		REQUIRE(suffix == immutable_list<int>{ 7, 7, 7 });
+		REQUIRE(runs.take(3) == prefix);
+		REQUIRE(memory_stats(runs.take(3)).node_count == 2);
+		REQUIRE(memory_stats(runs.take(3)).shared_bytes == 0);
+		REQUIRE(runs.reverse() == immutable_list<int>{ 7, 7, 7, 7, 7, 1 });
+		REQUIRE(memory_stats(runs.reverse()).node_count == 2);
+	}
+
+	SECTION("concat copies the left list and shares the right one") {
+		immutable_list<int> left{ -3, -2, -1 };
+		auto joined{ concat(left, list) };
+
+		REQUIRE(joined.size() == 1003);
+		REQUIRE(joined.front() == -3);
+		REQUIRE(&*std::next(joined.cbegin(), 3) == &list.front());
+		REQUIRE(memory_stats(joined).exclusive_bytes == nodeBytes * 3);
+		REQUIRE(concat(immutable_list<int>{}, list) == list);
+		REQUIRE(concat(list, immutable_list<int>{}) == list);
+	}
+
+	SECTION("reverse copies the list in a single slab") {
+		auto reversed{ list.reverse() };
+
+		REQUIRE(reversed.size() == 1000);
+		REQUIRE(std::equal(reversed.cbegin(), reversed.cend(), elements.crbegin(), elements.crend()));
+		REQUIRE(fragmentation(reversed) == fragmentation(list));
+		REQUIRE(reversed.reverse() == list);
+	}
+}
+
+TEST_CASE("sort/stable_sort generate a sorted list sharing the sorted suffix of the original one", "[immutable_list][sorting]") {
+	std::vector<int> elements(1000);
+	std::iota(elements.begin(), elements.end(), 0);
+
+	immutable_list<int> sortedList{ elements.cbegin(), elements.cend() };
+	auto nodeBytes{ memory_stats(sortedList).total_bytes() / sortedList.size() };
+
+	SECTION("A sorted list is returned as it is") {
+		REQUIRE(&sort(sortedList).front() == &sortedList.front());
+	}
+
+	SECTION("Only the elements that precede the part of the sorted suffix that follows them are copied") {
+		auto list{ sortedList.prepend({ 500, 3, 10 }) };
+		auto sorted{ sort(list) };
+
+		REQUIRE(sorted.size() == 1003);
+		REQUIRE(std::is_sorted(sorted.cbegin(), sorted.cend()));
+		REQUIRE(&*std::next(sorted.cbegin(), 503) == &*std::next(sortedList.cbegin(), 500));
+		REQUIRE(memory_stats(sorted).exclusive_bytes == nodeBytes * 503);
+	}
+
+	SECTION("A custom comparison is used to order the elements") {
+		immutable_list<int> list{ 1, 5, 2, 4, 3 };
+
+		REQUIRE(sort(list, std::greater<>{}) == immutable_list<int>{ 5, 4, 3, 2, 1 });
+	}
+
+	SECTION("stable_sort keeps the order of equivalent elements") {
+		immutable_list<std::pair<int, int>> list{ { 2, 0 }, { 1, 0 }, { 2, 1 }, { 1, 1 }, { 0, 0 }, { 1, 2 } };
+		auto byFirst{ [](const auto& left, const auto& right) { return left.first < right.first; } };
+
+		REQUIRE(stable_sort(list, byFirst) == immutable_list<std::pair<int, int>>{ { 0, 0 }, { 1, 0 }, { 1, 1 }, { 1, 2 }, { 2, 0 }, { 2, 1 } });
+	}
+
+	SECTION("Runs are sorted as their elements") {
+		immutable_list<int> list{ 5, 1 };
+		list = list.insert_after(list.cbegin(), 3, 4);
+
+		REQUIRE(sort(list) == immutable_list<int>{ 1, 4, 4, 4, 5 });
+	}
+
+	SECTION("Long lists can be sorted concurrently") {
+		std::vector<int> shuffled(200000);
+		for (std::size_t index{ 0 }; index < shuffled.size(); ++index) {
+			shuffled[index] = static_cast<int>((index * 7919) % shuffled.size());
+		}
+
+		immutable_list<int> list{ shuffled.cbegin(), shuffled.cend() };
+		auto sorted{ sort(execution::par, list) };
+		auto stableSorted{ stable_sort(execution::par, list, std::less<>{}) };
+
+		std::sort(shuffled.begin(), shuffled.end());
+
+		REQUIRE(std::equal(sorted.cbegin(), sorted.cend(), shuffled.cbegin(), shuffled.cend()));
+		REQUIRE(sorted == stableSorted);
+	}
+}
+
+TEST_CASE("radix_sort generates a list sorted by the arithmetic keys of its elements", "[immutable_list][sorting]") {
+	SECTION("Unsigned integers are sorted by value") {
+		std::vector<std::uint32_t> values(100000);
+		for (std::size_t index{ 0 }; index < values.size(); ++index) {
+			values[index] = static_cast<std::uint32_t>(index * 2654435761u);
+		}
+
+		immutable_list<std::uint32_t> list{ values.cbegin(), values.cend() };
+		auto sorted{ radix_sort(list) };
+
+		std::sort(values.begin(), values.end());
+
+		REQUIRE(std::equal(sorted.cbegin(), sorted.cend(), values.cbegin(), values.cend()));
+		REQUIRE(fragmentation(sorted) == fragmentation(immutable_list<std::uint32_t>{ values.cbegin(), values.cend() }));
+	}
+
+	SECTION("Signed integers and floating point numbers are ordered as numbers") {
+		immutable_list<std::int64_t> integers{ 3, -1, 0, -300, 42, -2 };
+		immutable_list<double> reals{ 2.5, -0.5, 0.0, -100.25, 1e10, -1e-10 };
+
+		REQUIRE(radix_sort(integers) == immutable_list<std::int64_t>{ -300, -2, -1, 0, 3, 42 });
+		REQUIRE(radix_sort(reals) == immutable_list<double>{ -100.25, -0.5, -1e-10, 0.0, 2.5, 1e10 });
+	}
+
+	SECTION("Records are sorted by key, keeping the order of the ones with equal keys") {
+		immutable_list<std::pair<std::uint16_t, char>> records{ { 2, 'a' }, { 1, 'b' }, { 2, 'c' }, { 0, 'd' }, { 1, 'e' } };
+		auto sorted{ radix_sort(records, [](const auto& record) { return record.first; }) };
+
+		REQUIRE(sorted == immutable_list<std::pair<std::uint16_t, char>>{ { 0, 'd' }, { 1, 'b' }, { 1, 'e' }, { 2, 'a' }, { 2, 'c' } });
+	}
+
+	SECTION("Runs are sorted as their elements") {
+		immutable_list<int> list{ 5, 1 };
+		list = list.insert_after(list.cbegin(), 3, -4);
+
+		REQUIRE(radix_sort(list) == immutable_list<int>{ -4, -4, -4, 1, 5 });
+		REQUIRE(radix_sort(immutable_list<int>{}).empty());
+	}
+}
@@ -0,0 +1,111 @@
+// Copyright 2018 Luca Di Sera
+//		Contact: disera.luca@gmail.com
+//				 https://github.com/diseraluca
+//				 https://www.linkedin.com/in/luca-di-sera-200023167
+//
+// This code is licensed under the MIT License.
+// More informations can be found in the LICENSE file in the root folder of this repository
+
+#include "catch.hpp"
+
+#include <soa_immutable_list.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace lds;
+
+using particle_list = soa_immutable_list<float, float, int>;
+
+TEST_CASE("A soa_immutable_list can be constructed from a range of tuples", "[soa_immutable_list][constructors]") {
+	std::vector<std::tuple<float, float, int>> particles{};
+	for (int index{ 0 }; index < 200; ++index) {
+		particles.emplace_back(index * 0.5f, index * 2.0f, index);
+	}
+
+	particle_list list{ particles.cbegin(), particles.cend() };
+
+	SECTION("The new list has the same elements, in the same order, of the original range") {
+		REQUIRE(list.size() == particles.size());
+		REQUIRE(std::equal(list.cbegin(), list.cend(), particles.cbegin(), particles.cend()));
+	}
+
+	SECTION("Elements can be accessed by index across chunks") {
+		REQUIRE(std::get<2>(list.front()) == 0);
+		REQUIRE(std::get<1>(list[150]) == 300.0f);
+		REQUIRE(std::get<0>(list.at(199)) == 99.5f);
+		REQUIRE_THROWS_AS(list.at(200), std::out_of_range);
+	}
+
+	SECTION("An empty range returns an empty list") {
+		REQUIRE(particle_list(particles.cbegin(), particles.cbegin()).empty());
+	}
+}
+
+TEST_CASE("soa_immutable_list::for_each_span visits each field as contiguous arrays", "[soa_immutable_list][iterators]") {
+	particle_list list{};
+	for (int index{ 0 }; index < 150; ++index) {
+		list = list.push_front(1.0f, static_cast<float>(index), index);
+	}
+
+	int total{ 0 };
+	std::size_t visited{ 0 };
+	list.for_each_span<2>([&total, &visited](column_span<int> ids) {
+		for (int id : ids) {
+			total += id;
+		}
+
+		visited += ids.size();
+	});
+
+	REQUIRE(visited == list.size());
+	REQUIRE(total == 149 * 150 / 2);
+}
+
+TEST_CASE("soa_immutable_list::push_front/pop_front create and return a new list with the head element added or removed", "[soa_immutable_list][modifiers]") {
+	soa_immutable_list<int, std::string> list{};
+	for (int index{ 0 }; index < 100; ++index) {
+		list = list.push_front(index, std::to_string(index));
+	}
+
+	SECTION("Prepending keeps the elements in order across chunks") {
+		REQUIRE(list.size() == 100);
+		REQUIRE(std::get<0>(list.front()) == 99);
+		REQUIRE(std::get<1>(list[99]) == "0");
+	}
+
+	SECTION("Popping leaves the original list untouched") {
+		auto popped{ list };
+		for (int count{ 0 }; count < 40; ++count) {
+			popped = popped.pop_front();
+		}
+
+		REQUIRE(popped.size() == 60);
+		REQUIRE(std::get<1>(popped.front()) == "59");
+		REQUIRE(list.size() == 100);
+		REQUIRE(std::get<0>(list.front()) == 99);
+	}
+
+	SECTION("Pushing onto a shared list does not modify the lists it was derived from") {
+		auto first{ list.pop_front().push_front(-1, "first") };
+		auto second{ list.pop_front().push_front(-2, "second") };
+
+		REQUIRE(std::get<1>(first.front()) == "first");
+		REQUIRE(std::get<1>(second.front()) == "second");
+		REQUIRE(std::get<1>(list.front()) == "99");
+	}
+
+	SECTION("push_front shares the first chunk with the list it was called on, unless another list has already done so") {
+		auto first{ list.push_front(100, "100") };
+		auto second{ list.push_front(101, "101") };
+
+		REQUIRE(std::next(first.cbegin()) == list.cbegin());
+		REQUIRE(std::next(second.cbegin()) != list.cbegin());
+		REQUIRE(std::get<1>(first.front()) == "100");
+		REQUIRE(std::get<1>(second.front()) == "101");
+		REQUIRE(std::equal(std::next(second.cbegin()), second.cend(), list.cbegin(), list.cend()));
+	}
+}
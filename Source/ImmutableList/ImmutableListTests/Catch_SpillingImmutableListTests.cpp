@@ -0,0 +1,120 @@
+// Copyright 2018 Luca Di Sera
+//		Contact: disera.luca@gmail.com
+//				 https://github.com/diseraluca
+//				 https://www.linkedin.com/in/luca-di-sera-200023167
+//
+// This code is licensed under the MIT License.
+// More informations can be found in the LICENSE file in the root folder of this repository
+
+#include "catch.hpp"
+
+#include <spilling_immutable_list.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+using namespace lds;
+
+namespace {
+	const char* const segmentFile{ "Catch_SpillingImmutableListTests.segments" };
+}
+
+TEST_CASE("A spilling_immutable_list keeps its resident segments within the memory budget of its store", "[spilling_immutable_list][constructors][memory]") {
+	{
+		auto store{ segment_store<std::int64_t>::create(segmentFile, 8 * 64 * sizeof(std::int64_t), 64) };
+
+		std::vector<std::int64_t> elements(10000);
+		std::iota(elements.begin(), elements.end(), 0);
+
+		spilling_immutable_list<std::int64_t> list{ store, elements.cbegin(), elements.cend() };
+
+		SECTION("Building a list larger than the budget spills its segments") {
+			REQUIRE(list.size() == elements.size());
+			REQUIRE(store->resident_bytes() <= store->memory_budget());
+		}
+
+		SECTION("Traversing the list faults the spilled segments back in") {
+			REQUIRE(std::equal(list.cbegin(), list.cend(), elements.cbegin(), elements.cend()));
+			REQUIRE(store->resident_bytes() <= store->memory_budget());
+		}
+
+		SECTION("Elements can be accessed by index") {
+			REQUIRE(list.front() == 0);
+			REQUIRE(list[5000] == 5000);
+			REQUIRE(list.at(9999) == 9999);
+			REQUIRE_THROWS_AS(list.at(10000), std::out_of_range);
+		}
+
+		SECTION("Dropping a list releases its segments") {
+			list = list.clear();
+
+			REQUIRE(store->resident_bytes() == 0);
+		}
+	}
+
+	std::remove(segmentFile);
+}
+
+TEST_CASE("spilling_immutable_list::push_front/pop_front create and return a new list with the head element added or removed", "[spilling_immutable_list][modifiers]") {
+	{
+		auto store{ segment_store<int>::create(segmentFile, 4 * 16 * sizeof(int), 16) };
+
+		spilling_immutable_list<int> list{ store };
+		std::vector<int> expected{};
+		for (int value{ 0 }; value < 500; ++value) {
+			list = list.push_front(value);
+			expected.insert(expected.begin(), value);
+		}
+
+		SECTION("Prepending keeps the elements in order across segments") {
+			REQUIRE(list.size() == expected.size());
+			REQUIRE(list.front() == 499);
+			REQUIRE(std::equal(list.cbegin(), list.cend(), expected.cbegin(), expected.cend()));
+		}
+
+		SECTION("Versions derived from a shared list do not affect each other") {
+			auto popped{ list.pop_front().pop_front() };
+			auto first{ popped.push_front(-1) };
+			auto second{ popped.push_front(-2) };
+
+			REQUIRE(first.front() == -1);
+			REQUIRE(second.front() == -2);
+			REQUIRE(list.front() == 499);
+			REQUIRE(first[1] == 497);
+			REQUIRE(std::equal(std::next(second.cbegin()), second.cend(), expected.cbegin() + 2, expected.cend()));
+		}
+
+		SECTION("Prepending shares the first segment with the list it was called on, unless another list has already done so") {
+			auto first{ list.push_front(-1) };
+			auto second{ list.push_front(-2) };
+
+			REQUIRE(std::next(first.cbegin()) == list.cbegin());
+			REQUIRE(std::next(second.cbegin()) != list.cbegin());
+			REQUIRE(first.front() == -1);
+			REQUIRE(second.front() == -2);
+			REQUIRE(std::equal(std::next(second.cbegin()), second.cend(), expected.cbegin(), expected.cend()));
+		}
+
+		SECTION("Prepending to a list whose first segment was spilled writes the element in the backing file") {
+			spilling_immutable_list<int> built{ store, expected.cbegin() + 3, expected.cend() };
+			REQUIRE(std::equal(built.cbegin(), built.cend(), expected.cbegin() + 3, expected.cend()));
+
+			auto pushed{ built.push_front(-1) };
+			REQUIRE(std::next(pushed.cbegin()) == built.cbegin());
+			REQUIRE(std::equal(built.cbegin(), built.cend(), expected.cbegin() + 3, expected.cend()));
+
+			auto repushed{ pushed.push_front(-2) };
+			REQUIRE(std::equal(built.cbegin(), built.cend(), expected.cbegin() + 3, expected.cend()));
+
+			REQUIRE(repushed.front() == -2);
+			REQUIRE(repushed[1] == -1);
+			REQUIRE(std::equal(std::next(repushed.cbegin(), 2), repushed.cend(), expected.cbegin() + 3, expected.cend()));
+		}
+	}
+
+	std::remove(segmentFile);
+}